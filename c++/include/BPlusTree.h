@@ -0,0 +1,324 @@
+/**
+ * @file BPlusTree.h
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing variables and method names for the BPlusTree class.
+ */
+
+#include <algorithm> // std::max, std::lower_bound
+#include <iostream> // << operator
+#include <stdexcept> // std::out_of_range
+#include <tuple> // std::forward_as_tuple
+#include <type_traits> // std::is_arithmetic
+#include <utility> // std::pair
+#include <vector> // levels built by assign
+
+#ifndef BPLUSTREE_H__
+#define BPLUSTREE_H__
+
+/**
+ * @brief Returns the default node size of B+ trees.
+ * @tparam TKey Type of node keys.
+ * @tparam TValue Type of node values.
+ * @return std::size_t 256 bytes, or the smallest multiple of a cache line in which both leaves
+ * and inner nodes hold BPlusTree::minFanOut, 4, elements or children.
+ */
+template <class TKey,class TValue>
+constexpr std::size_t bplusTreeNodeBytes()
+{
+	std::size_t leafBytes = 2 * sizeof(void *) + 4 * (sizeof(TKey) + sizeof(TValue));
+	std::size_t innerBytes = sizeof(std::size_t) + 4 * (sizeof(TKey) + sizeof(void *));
+	return (std::max({std::size_t(256), leafBytes, innerBytes}) + 63) / 64 * 64;
+}
+
+/**
+ * @brief Templated implementation of a B+ tree, a search tree with many keys per node.
+ * @tparam TKey Type of node keys, used for ordering.
+ * @tparam TValue Type of node values.
+ * @tparam TCompare Type of the custom comparison iterator between nodes. Default std::less<TKey>.
+ * @tparam TNodeBytes Approximate size of every node, rounded up to whole cache lines. Default 256, more
+ * for elements too large for nodes of minFanOut elements, see bplusTreeNodeBytes. Smaller sizes don't compile.
+ *
+ * It has the same interface as BinarySearchTree, but every node fills a few cache
+ * lines: inner nodes hold sorted separator keys and the pointers to their children,
+ * leaves hold the sorted keys and values in two contiguous arrays and a link to
+ * the next leaf. A lookup in a 10M elements tree touches about 6 nodes instead of
+ * 24, and iteration scans the leaves sequentially. Inside a node, arithmetic keys
+ * are searched with a branchless linear scan which the compiler vectorizes, other
+ * keys with a binary search. The tree is always balanced.
+ * Keys and values must be default constructible. Inserting an element may move
+ * the other ones, invalidating all iterators.
+ */
+template <class TKey,class TValue,class TCompare = std::less<TKey>,std::size_t TNodeBytes = bplusTreeNodeBytes<TKey, TValue>()>
+class BPlusTree
+{
+private:
+	/** Minimum number of elements of a leaf and of children of an inner node, which TNodeBytes must fit. */
+	static constexpr std::size_t minFanOut = 4;
+	static_assert(TNodeBytes >= 2 * sizeof(void *) + minFanOut * (sizeof(TKey) + sizeof(TValue)), "Leaves of TNodeBytes must hold at least minFanOut elements");
+	static_assert(TNodeBytes >= sizeof(std::size_t) + minFanOut * (sizeof(TKey) + sizeof(void *)), "Inner nodes of TNodeBytes must hold at least minFanOut children");
+	/** Number of elements of a leaf. */
+	static constexpr std::size_t leafCapacity = (TNodeBytes - 2 * sizeof(void *)) / (sizeof(TKey) + sizeof(TValue));
+	/** Number of children of an inner node. */
+	static constexpr std::size_t innerCapacity = (TNodeBytes - sizeof(std::size_t)) / (sizeof(TKey) + sizeof(void *));
+	/** Maximum number of levels of inner nodes, enough for any number of elements since nodes are at least half full. */
+	static constexpr int maxHeight = 64;
+	/**
+	 * @brief The part shared by inner nodes and leaves of the tree.
+	 */
+	struct Node;
+	/**
+	 * @brief An inner node of the tree, with separator keys and children.
+	 */
+	struct Inner;
+	/**
+	 * @brief A leaf of the tree, with the elements and a link to the next leaf.
+	 */
+	struct Leaf;
+
+public:
+	/**
+	 * @brief An iterator for the B+ tree class.
+	 */
+	class Iterator;
+	/**
+	 * @brief A constant iterator for the B+ tree class.
+	 */
+	class ConstIterator;
+	/** Type of node keys, named as in the standard associative containers. */
+	using key_type = TKey;
+	/** Type of node values, named as in the standard associative containers. */
+	using mapped_type = TValue;
+	/** Type of the key,value pairs, stored in separate arrays. */
+	using value_type = std::pair<const TKey, TValue>;
+
+private:
+	/** Root node of the tree, a leaf if height is 0. */
+	Node * root = nullptr;
+	/** The leaf with the lowest keys, where iterations begin. */
+	Leaf * firstLeaf = nullptr;
+	/** Number of levels of inner nodes above the leaves. */
+	int height = 0;
+	/** Number of elements of the tree. */
+	std::size_t elementCount = 0;
+	/**
+	 * @brief Counts the keys of a node which are less than a key.
+	 * @param keys The sorted keys of the node.
+	 * @param count The number of keys of the node.
+	 * @param key The key to be searched.
+	 * @return std::size_t The position of the first key not less than key.
+	 */
+	std::size_t lowerPosition(const TKey * keys, std::size_t count, const TKey& key) const;
+	/**
+	 * @brief Counts the keys of a node which are not greater than a key.
+	 * @param keys The sorted keys of the node.
+	 * @param count The number of keys of the node.
+	 * @param key The key to be searched.
+	 * @return std::size_t The position of the first key greater than key.
+	 */
+	std::size_t upperPosition(const TKey * keys, std::size_t count, const TKey& key) const;
+	/**
+	 * @brief Descends from the root to the leaf which contains or would contain a key.
+	 * @param key The key to be searched.
+	 * @param path If not nullptr, filled with the inner nodes visited from the root.
+	 * @param slots If not nullptr, filled with the position of the child taken in every visited inner node.
+	 * @return Leaf* The leaf, nullptr if the tree is empty.
+	 */
+	Leaf * findLeaf(const TKey& key, Inner ** path = nullptr, std::size_t * slots = nullptr) const;
+	/**
+	 * @brief Inserts a new node created by a split into the inner nodes above it, splitting them in turn if full.
+	 * @param path The inner nodes visited from the root to the split node.
+	 * @param slots The position of the child taken in every visited inner node.
+	 * @param separator The lowest key of the new node.
+	 * @param child The new node, to be placed right after the split one.
+	 */
+	void insertIntoParent(Inner ** path, std::size_t * slots, TKey separator, Node * child);
+	/**
+	 * @brief Inserts an element if its key is not already in the tree.
+	 * @param key The key of the element.
+	 * @param args The arguments forwarded to the std::pair<TKey, TValue> constructor, only used if the key is not present.
+	 * @return std::pair<Iterator, bool> An iterator to the element with the key and whether it was inserted.
+	 */
+	template <class... TArgs>
+	std::pair<Iterator, bool> insertUnique(const TKey& key, TArgs&&... args);
+	/**
+	 * @brief Recursively destroys a subtree.
+	 * @param node The root of the subtree.
+	 * @param level The number of levels of inner nodes in the subtree.
+	 */
+	static void destroy(Node * node, int level);
+
+public:
+	/**
+	 * @brief Default constructor for an empty B+ tree.
+	 */
+	BPlusTree() {}
+	/**
+	 * @brief Constructor for B+ tree with a single element.
+	 * @param d The key,value pair of the element.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 */
+	BPlusTree(std::pair<TKey, TValue> d, TCompare c = TCompare{}) : compare{c} { insert(std::move(d)); }
+	/**
+	 * @brief Constructor for B+ tree from a range sorted by key, in O(n) time.
+	 * @param first The iterator to the first key,value pair of the range.
+	 * @param last The iterator past the last key,value pair of the range.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 */
+	template <class TInputIterator>
+	BPlusTree(TInputIterator first, TInputIterator last, TCompare c = TCompare{}) : compare{c} { assign(first, last); }
+	/**
+	 * @brief Copy constructor, building a tree with full nodes in O(n) time.
+	 * @param bpt The tree to be copied.
+	 */
+	BPlusTree(const BPlusTree& bpt) : compare{bpt.compare} { assign(bpt.cbegin(), bpt.cend()); }
+	/**
+	 * @brief Move constructor.
+	 * @param bpt The tree whose nodes are moved, left empty.
+	 */
+	BPlusTree(BPlusTree&& bpt) noexcept : root{bpt.root}, firstLeaf{bpt.firstLeaf}, height{bpt.height}, elementCount{bpt.elementCount}, compare{std::move(bpt.compare)}
+	{
+		bpt.root = nullptr;
+		bpt.firstLeaf = nullptr;
+		bpt.height = 0;
+		bpt.elementCount = 0;
+	}
+	/**
+	 * @brief Destructor for B+ tree.
+	 */
+	~BPlusTree() { clear(); }
+	/**
+	 * @brief Used to insert a new element in the tree.
+	 * @param d The key,value pair to be inserted.
+	 * @return True if the element was inserted, false if the key was already present.
+	 */
+	bool insert(const std::pair<TKey, TValue>& d) { return insertUnique(d.first, d).second; }
+	/**
+	 * @brief Used to insert a new element in the tree, moving it.
+	 * @param d The key,value pair to be inserted.
+	 * @return True if the element was inserted, false if the key was already present.
+	 */
+	bool insert(std::pair<TKey, TValue>&& d) { return insertUnique(d.first, std::move(d)).second; }
+	/**
+	 * @brief Inserts an element with a value constructed in place, if the key is not present.
+	 * @param key The key of the element.
+	 * @param args The arguments forwarded to the value constructor, only used if the key is not present.
+	 * @return std::pair<Iterator, bool> An iterator to the element with the key and whether it was inserted.
+	 */
+	template <class... TArgs>
+	std::pair<Iterator, bool> try_emplace(const TKey& key, TArgs&&... args)
+	{
+		return insertUnique(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...));
+	}
+	/**
+	 * @brief Replaces the elements of the tree with a range sorted by key, in O(n) time.
+	 * @param first The iterator to the first key,value pair of the range.
+	 * @param last The iterator past the last key,value pair of the range.
+	 *
+	 * Leaves are filled completely and the inner levels are built bottom-up.
+	 * Elements whose key is not greater than the key of the previous element are skipped.
+	 * The new nodes replace the old ones only once built: if an exception is thrown they
+	 * are released and the tree is left unchanged.
+	 */
+	template <class TInputIterator>
+	void assign(TInputIterator first, TInputIterator last);
+	/**
+	 * @brief Removes all the elements of the tree.
+	 */
+	void clear();
+	/**
+	 * @brief Returns the number of elements of the tree, in constant time.
+	 */
+	std::size_t size() const { return elementCount; }
+	/**
+	 * @brief Prints elements in ascending key order.
+	 * @param os The stream to which elements are sent.
+	 */
+	std::ostream& printOrderedList(std::ostream& os) const;
+	/**
+	 * @brief Used to find an element inside the tree.
+	 * @param key The key of the element to be found.
+	 * @return Iterator An iterator to the element if it's found, else to end().
+	 */
+	Iterator find(const TKey& key) const;
+	/**
+	 * @brief Finds the first element whose key is not less than a key.
+	 * @param key The key to be searched.
+	 * @return Iterator An iterator to the element, end() if all keys are less than key.
+	 */
+	Iterator lower_bound(const TKey& key) const;
+	/**
+	 * @brief Finds the first element whose key is greater than a key.
+	 * @param key The key to be searched.
+	 * @return Iterator An iterator to the element, end() if no key is greater than key.
+	 */
+	Iterator upper_bound(const TKey& key) const;
+	/**
+	 * @brief Finds the range of elements whose key is equivalent to a key.
+	 * @param key The key to be searched.
+	 * @return std::pair<Iterator, Iterator> The lower_bound and upper_bound of the key.
+	 */
+	std::pair<Iterator, Iterator> equal_range(const TKey& key) const { return {lower_bound(key), upper_bound(key)}; }
+	/**
+	 * @brief Used to begin an iteration on the B+ tree.
+	 * @return Iterator An iterator to the element with the lowest key.
+	 */
+	Iterator begin() const { return elementCount ? Iterator{firstLeaf, 0} : end(); }
+	/**
+	 * @brief Used to finish an iteration on the B+ tree.
+	 * @return Iterator An iterator past the element with the highest key.
+	 */
+	Iterator end() const { return Iterator{nullptr, 0}; }
+	/**
+	 * @brief Used to begin an iteration on the B+ tree.
+	 * @return ConstIterator A constant iterator to the element with the lowest key.
+	 */
+	ConstIterator cbegin() const { return ConstIterator{begin()}; }
+	/**
+	 * @brief Used to finish an iteration on the B+ tree.
+	 * @return ConstIterator A constant iterator past the element with the highest key.
+	 */
+	ConstIterator cend() const { return ConstIterator{end()}; }
+	/**
+	 * @brief Custom comparison operator for the B+ tree.
+	 */
+	TCompare compare;
+	/**
+	 * @brief Copy assignment, building a tree with full nodes in O(n) time.
+	 * @param bpt The tree to be copied.
+	 */
+	BPlusTree& operator=(const BPlusTree& bpt);
+	/**
+	 * @brief Move assignment.
+	 * @param bpt The tree whose nodes are moved, left empty.
+	 */
+	BPlusTree& operator=(BPlusTree&& bpt) noexcept;
+	/**
+	 * @brief Operator [] to access an element value in the tree, inserting a default value if the key is not present.
+	 * @param key The key of the element which value should be accessed.
+	 * @return TValue& The value of the accessed element.
+	 */
+	TValue& operator[](const TKey& key) { return (*try_emplace(key).first).second; }
+	/**
+	 * @brief Operator [] to access an element value in the tree.
+	 * @param key The key of the element which value should be accessed.
+	 * @return const TValue& The value of the accessed element.
+	 * @throw std::out_of_range If the key is not present in the tree.
+	 */
+	const TValue& operator[](const TKey& key) const;
+	/**
+	 * @brief Operator << to print the B+ tree in ascending key order.
+	 * @param os The output stream to which the strings to be printed are appended.
+	 * @param bpt The B+ tree instance to be printed.
+	 * @return std::ostream& The output stream to which strings have been appended.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, BPlusTree const& bpt)
+	{
+		return bpt.printOrderedList(os);
+	}
+};
+
+#include "BPlusTreeSubclasses.hxx"
+#include "BPlusTreeMethods.hxx"
+
+#endif //BPLUSTREE_H__
@@ -0,0 +1,373 @@
+/**
+ * @file BPlusTreeMethods.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing method definitions for the BPlusTree class.
+ */
+
+#include "BPlusTree.h"
+
+// Private Methods
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+std::size_t BPlusTree<TKey, TValue, TCompare, TNodeBytes>::lowerPosition(const TKey * keys, std::size_t count, const TKey& key) const
+{
+    if constexpr(std::is_arithmetic<TKey>::value)
+    {
+        std::size_t position = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            position += compare(keys[i], key); // Branchless, vectorized by the compiler
+        }
+        return position;
+    }
+    else // Comparisons are expensive, so they are minimized
+    {
+        return std::lower_bound(keys, keys + count, key, compare) - keys;
+    }
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+std::size_t BPlusTree<TKey, TValue, TCompare, TNodeBytes>::upperPosition(const TKey * keys, std::size_t count, const TKey& key) const
+{
+    if constexpr(std::is_arithmetic<TKey>::value)
+    {
+        std::size_t position = 0;
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            position += !compare(key, keys[i]); // Branchless, vectorized by the compiler
+        }
+        return position;
+    }
+    else // Comparisons are expensive, so they are minimized
+    {
+        return std::upper_bound(keys, keys + count, key, compare) - keys;
+    }
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+typename BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Leaf * BPlusTree<TKey, TValue, TCompare, TNodeBytes>::findLeaf(const TKey& key, Inner ** path, std::size_t * slots) const
+{
+    Node * node = root;
+    for(int level = 0; level < height; ++level)
+    {
+        Inner * inner = static_cast<Inner *>(node);
+        std::size_t slot = upperPosition(inner->keys, inner->count - 1, key); // Separators are the lowest keys of the children
+        if(path)
+        {
+            path[level] = inner;
+            slots[level] = slot;
+        }
+        node = inner->children[slot];
+    }
+    return static_cast<Leaf *>(node);
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+void BPlusTree<TKey, TValue, TCompare, TNodeBytes>::insertIntoParent(Inner ** path, std::size_t * slots, TKey separator, Node * child)
+{
+    for(int level = height - 1; level >= 0; --level)
+    {
+        Inner * parent = path[level];
+        std::size_t slot = slots[level];
+        if(parent->count < innerCapacity)
+        {
+            std::move_backward(parent->keys + slot, parent->keys + parent->count - 1, parent->keys + parent->count);
+            std::move_backward(parent->children + slot + 1, parent->children + parent->count, parent->children + parent->count + 1);
+            parent->keys[slot] = std::move(separator);
+            parent->children[slot + 1] = child;
+            ++parent->count;
+            return;
+        }
+        // The parent is full: its keys and children are gathered with the new ones and split in half
+        TKey keys[innerCapacity];
+        Node * children[innerCapacity + 1];
+        std::move(parent->keys, parent->keys + slot, keys);
+        keys[slot] = std::move(separator);
+        std::move(parent->keys + slot, parent->keys + innerCapacity - 1, keys + slot + 1);
+        std::copy(parent->children, parent->children + slot + 1, children);
+        children[slot + 1] = child;
+        std::copy(parent->children + slot + 1, parent->children + innerCapacity, children + slot + 2);
+        Inner * sibling = new Inner;
+        std::size_t leftCount = (innerCapacity + 1) / 2;
+        parent->count = leftCount;
+        sibling->count = innerCapacity + 1 - leftCount;
+        std::move(keys, keys + leftCount - 1, parent->keys);
+        std::copy(children, children + leftCount, parent->children);
+        std::move(keys + leftCount, keys + innerCapacity, sibling->keys);
+        std::copy(children + leftCount, children + innerCapacity + 1, sibling->children);
+        separator = std::move(keys[leftCount - 1]); // Moved up, as the lowest key of the sibling
+        child = sibling;
+    }
+    Inner * newRoot = new Inner;
+    newRoot->count = 2;
+    newRoot->keys[0] = std::move(separator);
+    newRoot->children[0] = root;
+    newRoot->children[1] = child;
+    root = newRoot;
+    ++height;
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+template <class... TArgs>
+std::pair<typename BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Iterator, bool> BPlusTree<TKey, TValue, TCompare, TNodeBytes>::insertUnique(const TKey& key, TArgs&&... args)
+{
+    Inner * path[maxHeight];
+    std::size_t slots[maxHeight];
+    Leaf * leaf = findLeaf(key, path, slots);
+    std::size_t position = leaf ? lowerPosition(leaf->keys, leaf->count, key) : 0;
+    if(leaf && position < leaf->count && !compare(key, leaf->keys[position])) // Element already present
+    {
+        return {Iterator{leaf, position}, false};
+    }
+    std::pair<TKey, TValue> element(std::forward<TArgs>(args)...);
+    if(!leaf) // Tree is empty
+    {
+        leaf = new Leaf;
+        root = leaf;
+        firstLeaf = leaf;
+    }
+    Leaf * split = nullptr;
+    if(leaf->count == leafCapacity)
+    {
+        split = new Leaf;
+        // Appending to the last leaf starts a new one, so that sorted insertions fill the leaves
+        std::size_t moved = (leaf->next || position < leaf->count) ? leaf->count / 2 : 0;
+        std::move(leaf->keys + leaf->count - moved, leaf->keys + leaf->count, split->keys);
+        std::move(leaf->values + leaf->count - moved, leaf->values + leaf->count, split->values);
+        split->count = moved;
+        leaf->count -= moved;
+        split->next = leaf->next;
+        leaf->next = split;
+        if(position > leaf->count || !moved)
+        {
+            position -= leaf->count;
+            leaf = split;
+        }
+    }
+    std::move_backward(leaf->keys + position, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+    std::move_backward(leaf->values + position, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+    leaf->keys[position] = std::move(element.first);
+    leaf->values[position] = std::move(element.second);
+    ++leaf->count;
+    ++elementCount;
+    if(split)
+    {
+        insertIntoParent(path, slots, split->keys[0], split);
+    }
+    return {Iterator{leaf, position}, true};
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+void BPlusTree<TKey, TValue, TCompare, TNodeBytes>::destroy(Node * node, int level)
+{
+    if(!level)
+    {
+        delete static_cast<Leaf *>(node);
+        return;
+    }
+    Inner * inner = static_cast<Inner *>(node);
+    for(std::size_t i = 0; i < inner->count; ++i)
+    {
+        destroy(inner->children[i], level - 1);
+    }
+    delete inner;
+}
+
+// Public methods
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+template <class TInputIterator>
+void BPlusTree<TKey, TValue, TCompare, TNodeBytes>::assign(TInputIterator first, TInputIterator last)
+{
+    std::vector<std::pair<Node *, const TKey *>> level; // The nodes of a level with their lowest key
+    std::vector<std::pair<Node *, const TKey *>> above; // The parents being created for the level
+    Leaf * leaves = nullptr;
+    int levels = 0;
+    std::size_t count = 0;
+    try // The new nodes are only reachable from these locals until the tree is complete
+    {
+        Leaf * leaf = nullptr;
+        for(; first != last; ++first)
+        {
+            if(leaf && !compare(leaf->keys[leaf->count - 1], (*first).first))
+            {
+                continue; // Not sorted or duplicated key
+            }
+            if(!leaf || leaf->count == leafCapacity)
+            {
+                Leaf * next = new Leaf;
+                (leaf ? leaf->next : leaves) = next;
+                leaf = next;
+                level.emplace_back(leaf, leaf->keys);
+            }
+            leaf->keys[leaf->count] = (*first).first;
+            leaf->values[leaf->count] = (*first).second;
+            ++leaf->count;
+            ++count;
+        }
+        while(level.size() > 1) // Builds the level above, spreading the nodes evenly so that every parent has at least two children
+        {
+            std::size_t parents = (level.size() + innerCapacity - 1) / innerCapacity;
+            above.clear();
+            above.reserve(parents);
+            std::size_t next = 0;
+            for(std::size_t p = 0; p < parents; ++p)
+            {
+                Inner * inner = new Inner;
+                above.emplace_back(inner, nullptr);
+                inner->count = level.size() / parents + (p < level.size() % parents);
+                for(std::size_t i = 0; i < inner->count; ++i, ++next)
+                {
+                    inner->children[i] = level[next].first;
+                    if(i)
+                    {
+                        inner->keys[i - 1] = *level[next].second;
+                    }
+                }
+                above.back().second = level[next - inner->count].second;
+            }
+            level.swap(above);
+            ++levels;
+        }
+    }
+    catch(...)
+    {
+        for(auto& parent : above) // Their children are still owned by the level
+        {
+            delete static_cast<Inner *>(parent.first);
+        }
+        if(levels)
+        {
+            for(auto& node : level)
+            {
+                destroy(node.first, levels);
+            }
+        }
+        while(leaves && !levels)
+        {
+            Leaf * next = leaves->next;
+            delete leaves;
+            leaves = next;
+        }
+        throw;
+    }
+    clear();
+    root = level.empty() ? nullptr : level.front().first;
+    firstLeaf = leaves;
+    height = levels;
+    elementCount = count;
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+void BPlusTree<TKey, TValue, TCompare, TNodeBytes>::clear()
+{
+    if(root)
+    {
+        destroy(root, height);
+    }
+    root = nullptr;
+    firstLeaf = nullptr;
+    height = 0;
+    elementCount = 0;
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+std::ostream& BPlusTree<TKey, TValue, TCompare, TNodeBytes>::printOrderedList(std::ostream& os) const
+{
+    ConstIterator it{cbegin()};
+    ConstIterator end{cend()};
+    if(it == end)
+    {
+        os << "Empty" << std::endl;
+    }
+    for(; it != end; ++it)
+    {
+        os << (*it).first << ": " << (*it).second << std::endl;
+    }
+    return os;
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+typename BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Iterator BPlusTree<TKey, TValue, TCompare, TNodeBytes>::find(const TKey& key) const
+{
+    Leaf * leaf = findLeaf(key);
+    if(!leaf)
+    {
+        return end();
+    }
+    std::size_t position = lowerPosition(leaf->keys, leaf->count, key);
+    if(position < leaf->count && !compare(key, leaf->keys[position]))
+    {
+        return Iterator{leaf, position};
+    }
+    return end();
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+typename BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Iterator BPlusTree<TKey, TValue, TCompare, TNodeBytes>::lower_bound(const TKey& key) const
+{
+    Leaf * leaf = findLeaf(key);
+    if(!leaf)
+    {
+        return end();
+    }
+    std::size_t position = lowerPosition(leaf->keys, leaf->count, key);
+    // All the keys of the leaf are less than key: the bound is the first element of the next leaf
+    return position < leaf->count ? Iterator{leaf, position} : Iterator{leaf->next, 0};
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+typename BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Iterator BPlusTree<TKey, TValue, TCompare, TNodeBytes>::upper_bound(const TKey& key) const
+{
+    Leaf * leaf = findLeaf(key);
+    if(!leaf)
+    {
+        return end();
+    }
+    std::size_t position = upperPosition(leaf->keys, leaf->count, key);
+    return position < leaf->count ? Iterator{leaf, position} : Iterator{leaf->next, 0};
+}
+
+// Operators
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+BPlusTree<TKey, TValue, TCompare, TNodeBytes>& BPlusTree<TKey, TValue, TCompare, TNodeBytes>::operator=(const BPlusTree& bpt)
+{
+    if(this != &bpt)
+    {
+        compare = bpt.compare;
+        assign(bpt.cbegin(), bpt.cend());
+    }
+    return *this;
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+BPlusTree<TKey, TValue, TCompare, TNodeBytes>& BPlusTree<TKey, TValue, TCompare, TNodeBytes>::operator=(BPlusTree&& bpt) noexcept
+{
+    if(this != &bpt)
+    {
+        clear();
+        root = bpt.root;
+        firstLeaf = bpt.firstLeaf;
+        height = bpt.height;
+        elementCount = bpt.elementCount;
+        compare = std::move(bpt.compare);
+        bpt.root = nullptr;
+        bpt.firstLeaf = nullptr;
+        bpt.height = 0;
+        bpt.elementCount = 0;
+    }
+    return *this;
+}
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+const TValue& BPlusTree<TKey, TValue, TCompare, TNodeBytes>::operator[](const TKey& key) const
+{
+    Iterator it{find(key)};
+    if (it == end())
+    {
+        throw std::out_of_range{"The key is not present in the tree."};
+    }
+    return (*it).second;
+}
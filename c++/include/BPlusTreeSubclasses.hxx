@@ -0,0 +1,125 @@
+/**
+ * @file BPlusTreeSubclasses.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing Node, Inner, Leaf, Iterator and ConstIterator nested classes of BPlusTree.
+ */
+
+#include "BPlusTree.h"
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+struct BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Node
+{
+	/** Number of elements of a leaf, or of children of an inner node. */
+	std::size_t count = 0;
+};
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+struct alignas(64) BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Inner : Node
+{
+	/** The lowest key of every child but the first one. */
+	TKey keys[innerCapacity - 1];
+	/** The children, all inner nodes or all leaves. */
+	Node * children[innerCapacity];
+};
+
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+struct alignas(64) BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Leaf : Node
+{
+	/** The keys of the elements in ascending order. */
+	TKey keys[leafCapacity];
+	/** The values of the elements, in the same order of the keys. */
+	TValue values[leafCapacity];
+	/** The leaf with the next keys, nullptr for the last one. */
+	Leaf * next = nullptr;
+};
+
+/**
+ * @brief An iterator for the B+ tree class.
+ *
+ * Keys and values are stored in separate arrays, so the dereferencing operator
+ * returns a pair of references instead of a reference to a pair.
+ */
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+class BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Iterator
+{
+private:
+	friend class BPlusTree;
+	/** The leaf of the current element, nullptr for end(). */
+	Leaf * leaf;
+	/** The position of the current element in its leaf. */
+	std::size_t position;
+public:
+	/**
+	 * @brief Construct an iterator on an element of the tree.
+	 * @param l The leaf of the element.
+	 * @param p The position of the element in the leaf.
+	 */
+	Iterator(Leaf * l, std::size_t p) : leaf{l}, position{p} {}
+	/**
+	 * @brief Operator it() for deferencing a B+ tree iterator.
+	 * @return std::pair<const TKey&, TValue&> References to current element's key and value.
+	 */
+	std::pair<const TKey&, TValue&> operator*() const { return std::pair<const TKey&, TValue&>{leaf->keys[position], leaf->values[position]}; }
+	/**
+	 * @brief Operator ++it to advance iterator to the next element.
+	 * @return Iterator& Reference to an iterator pointing on the next element.
+	 */
+	Iterator& operator++()
+	{
+		if(leaf && ++position == leaf->count) // First element of the next leaf
+		{
+			leaf = leaf->next;
+			position = 0;
+		}
+		return *this;
+	}
+	/**
+	 * @brief Operator it++ to advance iterator to the next element.
+	 * @return Iterator Value of the current iterator before advancing it to the next element.
+	 */
+	Iterator operator++(int)
+	{
+		Iterator it{*this};
+		++(*this);
+		return it;
+	}
+	/**
+	 * @brief Operator == to check for iterators equality.
+	 * @param other The iterator to be compared with this one.
+	 * @return True if iterators point to the same element, else false
+	 */
+	bool operator==(const Iterator& other) const { return leaf == other.leaf && position == other.position; }
+	/**
+	 * @brief Operator != to check for iterators inequality.
+	 * @param other The iterator to be compared with this one.
+	 * @return False if iterators point to the same element, else true.
+	 */
+	bool operator!=(const Iterator& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief A constant iterator for the B+ tree class.
+ *
+ * It inherits all the methods from Iterator, except for the dereferencing
+ * operator which returns constant references.
+ */
+template <class TKey,class TValue,class TCompare,std::size_t TNodeBytes>
+class BPlusTree<TKey, TValue, TCompare, TNodeBytes>::ConstIterator : public BPlusTree<TKey, TValue, TCompare, TNodeBytes>::Iterator
+{
+public:
+	/**
+	 * @brief Construct a constant iterator from an iterator.
+	 * @param it The iterator on the same element.
+	 */
+	explicit ConstIterator(const Iterator& it) : Iterator{it} {}
+	/**
+	 * @brief Operator it() for deferencing a constant B+ tree iterator.
+	 * @return std::pair<const TKey&, const TValue&> Constant references to current element's key and value.
+	 */
+	std::pair<const TKey&, const TValue&> operator*() const
+	{
+		std::pair<const TKey&, TValue&> pair{Iterator::operator*()};
+		return std::pair<const TKey&, const TValue&>{pair.first, pair.second};
+	}
+};
@@ -5,20 +5,44 @@
  * @brief Header containing variables and method names for the BinarySearchTree class.
  */
 
+#include <algorithm> // std::max
+#include <atomic> // std::atomic
+#include <cmath> // std::pow
+#include <cstdint> // fixed width integers of snapshots
+#include <future> // std::async
 #include <iostream> // << operator
 #include <memory> // unique pointers
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <system_error> // std::system_error
+#include <thread> // std::thread::hardware_concurrency
+#include <tuple> // std::forward_as_tuple
+#include <type_traits> // std::is_trivially_destructible
 #include <vector> // vector class
+#include "BinarySearchTreePolicies.h" // balancing, allocation and augmentation policies
+#include "FrozenBinarySearchTree.h" // read-optimized snapshots
+#include "BinarySearchTreeSnapshot.h" // binary snapshot format
 
 #ifndef BINARYSEARCHTREE_H__
 #define BINARYSEARCHTREE_H__
 
+#ifdef BSTCOUNTERS
+/** Adds an amount to one of the operation counters of the tree. */
+#define BST_COUNT(counter, amount) operationCounters.counter.fetch_add(amount, std::memory_order_relaxed)
+#else
+/** Operation counters are disabled, nothing is counted. */
+#define BST_COUNT(counter, amount) ((void)0)
+#endif
+
 /**
  * @brief Templated implementation of a binary search tree.
  * @tparam TKey Type of node keys, used for ordering.
  * @tparam TValue Type of node values.
  * @tparam TCompare Type of the custom comparison iterator between nodes. Default std::less<TKey>.
+ * @tparam TBalance Balancing policy applied on insertion. Default NoBalancing.
+ * @tparam TAllocator Allocation policy used to create the nodes. Default HeapAllocation.
+ * @tparam TAugmentation Augmentation policy storing additional data in the nodes. Default NoAugmentation.
  */
-template <class TKey,class TValue,class TCompare = std::less<TKey>>
+template <class TKey,class TValue,class TCompare = std::less<TKey>,class TBalance = NoBalancing,class TAllocator = HeapAllocation,class TAugmentation = NoAugmentation>
 class BinarySearchTree
 {
 private:
@@ -26,6 +50,8 @@ private:
 	 * @brief A node of the binary search tree with two children nodes and one parent node.
 	 */
 	struct Node;
+	/** Owning pointer to a node, releasing it according to the allocation policy. */
+	using NodePtr = std::unique_ptr<Node, typename TAllocator::template Deleter<Node>>;
 
 public:
 	/**
@@ -36,10 +62,114 @@ public:
 	 * @brief A constant iterator for the binary search tree class.
 	 */
 	class ConstIterator;
+	/** Type of node keys, named as in the standard associative containers. */
+	using key_type = TKey;
+	/** Type of node values, named as in the standard associative containers. */
+	using mapped_type = TValue;
+	/** Type of the key,value pairs stored in the nodes. */
+	using value_type = std::pair<const TKey, TValue>;
+	/**
+	 * @brief Statistics on the shape of the tree, as returned by stats().
+	 */
+	struct Statistics
+	{
+		/** Number of nodes of the tree. */
+		std::size_t size = 0;
+		/** Number of levels of the tree, 0 if it is empty. */
+		int height = 0;
+		/** Average number of links between the nodes and the root. */
+		double averageDepth = 0;
+		/** Number of links between the deepest node and the root. */
+		int maxDepth = 0;
+		/** Number of nodes at every depth, starting from the root. */
+		std::vector<std::size_t> depthHistogram;
+	};
+	/**
+	 * @brief Values of the operation counters, as returned by counters().
+	 *
+	 * Counters are only updated if BSTCOUNTERS is defined at compile time, otherwise they are always zero.
+	 */
+	struct Counters
+	{
+		/** Number of lookups through find. */
+		std::size_t finds = 0;
+		/** Number of nodes inserted one by one, bulk operations excluded. */
+		std::size_t inserts = 0;
+		/** Number of key comparisons performed while searching the tree. */
+		std::size_t comparisons = 0;
+		/** Number of nodes visited while searching the tree. */
+		std::size_t visitedNodes = 0;
+		/** Number of nodes created. */
+		std::size_t allocations = 0;
+		/** Number of subtrees rebuilt because of the auto balance threshold. */
+		std::size_t autoBalances = 0;
+	};
 
 private:
+	/** Arena from which nodes are created, declared before root to outlive the nodes. */
+	typename TAllocator::template Arena<Node> nodeArena;
 	/** Root node of the binary search tree. */
-	std::unique_ptr<Node> root;
+	NodePtr root;
+	/** Node with the highest key, used to append elements in constant time. */
+	Node * rightmost = nullptr;
+	/** Number of nodes of the tree. */
+	std::size_t nodeCount = 0;
+	/** Multiple of the optimal height above which the tree is balanced on insertion, 0 to disable. */
+	double autoBalanceFactor = 0;
+	/** Insertions since the last automatic balance of a self-balancing tree. */
+	std::size_t autoBalanceInserts = 0;
+	#ifdef BSTCOUNTERS
+	/**
+	 * @brief Operation counters, atomic so that constant methods can be called concurrently.
+	 */
+	struct AtomicCounters
+	{
+		std::atomic<std::size_t> finds{0};
+		std::atomic<std::size_t> inserts{0};
+		std::atomic<std::size_t> comparisons{0};
+		std::atomic<std::size_t> visitedNodes{0};
+		std::atomic<std::size_t> allocations{0};
+		std::atomic<std::size_t> autoBalances{0};
+	};
+	/** Operation counters, updated through BST_COUNT. */
+	mutable AtomicCounters operationCounters;
+	#endif
+	/**
+	 * @brief Rebuilds part of the tree if a new node is deeper than the auto balance threshold.
+	 * @param node The inserted node.
+	 */
+	void autoBalance(Node * node);
+	/**
+	 * @brief Overload of autoRebuild for unbalanced trees, rebuilds the subtree of a scapegoat of the node.
+	 * @param node The inserted node, deeper than the auto balance threshold.
+	 *
+	 * The scapegoat is the lowest ancestor with a child holding more than 2^(-1/factor) of its nodes,
+	 * one is always found above a node deeper than factor * log2(n). As in scapegoat trees, rebuilds
+	 * cost O(log n) amortized time per insertion, even if the elements are inserted in sorted order.
+	 */
+	void autoRebuild(Node * node, NoBalancing);
+	/** @brief Overload of autoRebuild for AVL trees, whose subtrees can't be rebuilt alone. */
+	void autoRebuild(Node *, AVLBalancing) { autoRebuildTree(); }
+	/** @brief Overload of autoRebuild for red-black trees, whose subtrees can't be rebuilt alone. */
+	void autoRebuild(Node *, RedBlackBalancing) { autoRebuildTree(); }
+	/**
+	 * @brief Balances the whole tree, unless it was balanced automatically less than n/2 insertions before.
+	 * 
+	 * Rebuilds cost O(1) amortized time per insertion.
+	 */
+	void autoRebuildTree();
+	/**
+	 * @brief Counts the nodes of a subtree, without recursion.
+	 * @param node The root of the subtree.
+	 * @return std::size_t The number of nodes of the subtree.
+	 */
+	static std::size_t countNodes(const Node * node);
+	/**
+	 * @brief Rebuilds a subtree into a balanced one, in O(size) time without allocations.
+	 * @param node The root of the subtree.
+	 * @param size The number of nodes of the subtree.
+	 */
+	void rebuildSubtree(Node * node, std::size_t size);
 	/**
 	 * @brief Finds the nearest element to the element with a key inside the tree.
 	 * @param key The key of the element to be found.
@@ -49,26 +179,246 @@ private:
 	 * If the element is present, it returns an iterator to the element.
 	 * If the element is not present, it returns an iterator to the element
 	 * which would be the parent of the element if it was present.
+	 * The key may be of any type comparable with TKey through TCompare.
+	 */
+	template <class TKeyArg>
+	Iterator findNearest(const TKeyArg& key) const;
+	/**
+	 * @brief Finds the element with a key equivalent to the given one according to TCompare.
+	 * @param key The key of the element to be found.
+	 * @return Iterator An iterator to the element if it's found, else to end().
 	 */
-	Iterator findNearest(const TKey& key) const;
+	template <class TKeyArg>
+	Iterator findEquivalent(const TKeyArg& key) const;
 	/**
-	 * @brief Recursive private method used to create a deep copy of a binary search tree.
+	 * @brief Private method used to create a deep copy of a binary search tree.
 	 * @param node The root node of the tree that should be copied.
+	 * 
+	 * The shape of the copied tree is cloned node by node in a single iterative pass,
+	 * without any key comparison and using the parent pointers instead of a stack.
 	 */
-	void copy(const std::unique_ptr<Node>& node);
+	void copy(const NodePtr& node);
 	/**
-	 * @brief Recursively rebuilds a balanced tree from an ordered list of pairs.
-	 * @param nodes An orderer list of pairs in key,value format.
-	 * @param firstId The id of the first element of the list, for recursion purposes.
-	 * @param lastId The id of the last element of the list, for recursion purposes.
+	 * @brief Creates a new node and links it as a child of an existing one.
+	 * @param parent The parent of the new node, nullptr if the tree is empty.
+	 * @param right If the new node should be the right or the left child of its parent.
+	 * @param args The arguments forwarded to the constructor of the node's key,value pair.
+	 * @return Node* The created node.
+	 * 
+	 * The caller must ensure that the child is free and that the order is preserved.
+	 * After the insertion the tree is rebalanced according to the TBalance policy.
+	 */
+	template <class... TArgs>
+	Node * attach(Node * parent, bool right, TArgs&&... args);
+	/**
+	 * @brief Creates a new node in a single traversal if its key is not already present.
+	 * @param key The key of the node, must be equivalent to the key built from args.
+	 * @param args The arguments forwarded to the constructor of the node's key,value pair.
+	 * @return std::pair<Iterator, bool> An iterator to the node with the key, and true if it was created.
+	 * 
+	 * The arguments are only consumed if the node is created.
+	 */
+	template <class... TArgs>
+	std::pair<Iterator, bool> insertUnique(const TKey& key, TArgs&&... args);
+	/**
+	 * @brief Returns the unique pointer owning a node, either its parent's child or the root.
+	 * @param node The node whose owner should be returned.
+	 * @return NodePtr& The pointer owning the node.
+	 */
+	NodePtr& ownerOf(Node * node);
+	/**
+	 * @brief Rotates a node to the left, making its right child the new root of the subtree.
+	 * @param node The node to be rotated.
+	 */
+	void rotateLeft(Node * node);
+	/**
+	 * @brief Rotates a node to the right, making its left child the new root of the subtree.
+	 * @param node The node to be rotated.
+	 */
+	void rotateRight(Node * node);
+	/**
+	 * @brief Recomputes the balancing and augmentation data of a node from the data of its children.
+	 * @param node The node to be updated.
 	 */
-	void rebuildBalancedTree(std::vector<std::pair<TKey, TValue>>& nodes, int firstId, int lastId);
+	void updateNode(Node * node) { updateNode(node, TBalance{}); updateNode(node, TAugmentation{}); }
+	/** @brief Overload of updateNode for trees without augmentation data. */
+	void updateNode(Node *, NoAugmentation) {}
+	/** @brief Overload of updateNode for order statistic trees, updates the subtree size. */
+	void updateNode(Node * node, OrderStatistics) { node->size = 1 + subtreeSize(node->left) + subtreeSize(node->right); }
+	/**
+	 * @brief Returns the number of nodes of a subtree of an order statistic tree.
+	 * @param node The root of the subtree, possibly empty.
+	 */
+	static std::size_t subtreeSize(const NodePtr& node) { return node ? node->size : 0; }
+	/** @brief Overload of updateAncestors for trees without augmentation data. */
+	void updateAncestors(Node *, NoAugmentation) {}
+	/**
+	 * @brief Increases the subtree size of all the ancestors of a node which has just been inserted.
+	 * @param node The inserted node.
+	 */
+	void updateAncestors(Node * node, OrderStatistics);
+	/**
+	 * @brief Checks at compile time that the order statistic methods are available.
+	 */
+	static void requireOrderStatistics()
+	{
+		static_assert(std::is_same<TAugmentation, OrderStatistics>::value, "The tree must use the OrderStatistics augmentation policy");
+	}
+	/** @brief Overload of updateNode for trees without balancing data. */
+	void updateNode(Node *, NoBalancing) {}
+	/** @brief Overload of updateNode for AVL trees, updates the node height. */
+	void updateNode(Node * node, AVLBalancing);
+	/** @brief Overload of updateNode for red-black trees, colors don't depend on children. */
+	void updateNode(Node *, RedBlackBalancing) {}
+	/**
+	 * @brief Restores the balancing policy invariants after a node insertion.
+	 * @param node The node which has just been inserted.
+	 */
+	void rebalance(Node * node) { rebalance(node, TBalance{}); }
+	/** @brief Overload of rebalance for unbalanced trees, performs no action. */
+	void rebalance(Node *, NoBalancing) {}
+	/** @brief Overload of rebalance for AVL trees, retraces heights and rotates the first unbalanced node. */
+	void rebalance(Node * node, AVLBalancing);
+	/** @brief Overload of rebalance for red-black trees, recolors and rotates up to the root. */
+	void rebalance(Node * node, RedBlackBalancing);
+	/**
+	 * @brief Turns the tree into a vine, a list of nodes linked by their right children.
+	 * @return std::size_t The number of nodes of the tree.
+	 * 
+	 * First phase of the Day-Stout-Warren algorithm, performed through right rotations.
+	 */
+	std::size_t treeToVine();
+	/**
+	 * @brief Turns a vine into a balanced tree, in which only the last level may be incomplete.
+	 * @param size The number of nodes of the vine.
+	 * 
+	 * Second phase of the Day-Stout-Warren algorithm, performed through left rotations.
+	 * The balancing data of all nodes is refreshed at the end.
+	 */
+	void vineToTree(std::size_t size);
+	/**
+	 * @brief Links the nodes of a vine into a balanced tree, recursively splitting them by their median.
+	 * @param vine The head of the vine, advanced past the linked nodes.
+	 * @param size The number of nodes to be linked.
+	 * @param parent The parent of the resulting subtree.
+	 * @return NodePtr The root of the resulting subtree.
+	 * 
+	 * Unlike vineToTree, the nodes are visited once in order, so it is faster
+	 * on freshly created vines. The balancing data of the nodes is not refreshed.
+	 */
+	NodePtr linkVine(NodePtr& vine, std::size_t size, Node * parent);
+	/**
+	 * @brief Appends a new node to the vine in root, after the rightmost node.
+	 * @param args The arguments forwarded to the node constructor.
+	 */
+	template <class... TArgs>
+	void appendToVine(TArgs&&... args);
+	/**
+	 * @brief Links the vine in root into a balanced tree and refreshes the data of all nodes.
+	 * @param size The number of nodes of the vine.
+	 */
+	void linkTree(std::size_t size);
+	/**
+	 * @brief Merges the nodes of two trees in order, copying the selected ones into a new balanced tree.
+	 * @tparam TLeft Whether keys only present in this tree are copied.
+	 * @tparam TBoth Whether keys present in both trees are copied, with the value of this tree.
+	 * @tparam TRight Whether keys only present in the other tree are copied.
+	 * @param other The other tree.
+	 * @return BinarySearchTree The new tree, using the comparison operator of this tree.
+	 */
+	template <bool TLeft, bool TBoth, bool TRight>
+	BinarySearchTree combine(const BinarySearchTree& other) const;
+	/**
+	 * @brief Writes a section of a binary snapshot, with a field of every element in ascending key order.
+	 * @tparam T The type of the field, trivially copyable or a string.
+	 * @param os The stream to which the section is written.
+	 * @param checksum The checksum of the snapshot, updated with the section.
+	 * @param field Function returning the field of a constant key,value pair.
+	 * @return std::uint64_t The number of bytes written.
+	 */
+	template <class T, class TField>
+	std::uint64_t saveSection(std::ostream& os, std::uint64_t& checksum, TField field) const;
+	/**
+	 * @brief Reads a section of a binary snapshot.
+	 * @tparam T The type of the field, trivially copyable or a string.
+	 * @param is The stream from which the section is read.
+	 * @param checksum The checksum of the snapshot, updated with the section.
+	 * @param count The number of fields to be read.
+	 * @param offset The offset of the section in the snapshot, advanced past it.
+	 * @return std::vector<T> The fields in ascending key order.
+	 * @throw std::runtime_error If the stream ends before the section.
+	 * 
+	 * Fields are read in blocks, so that a corrupted count fails at the end of the
+	 * stream instead of allocating memory for all of them at once.
+	 */
+	template <class T>
+	static std::vector<T> loadSection(std::istream& is, std::uint64_t& checksum, std::uint64_t count, std::uint64_t& offset);
+	/**
+	 * @brief Splits a subtree in disjoint pieces in key order, for parallel processing.
+	 * @param node The root of the subtree.
+	 * @param depth The depth below which whole subtrees are kept in a single piece.
+	 * @param pieces The pieces to which the ones of the subtree are appended.
+	 * 
+	 * Every piece is a node, together with its whole subtree if the flag is set.
+	 * Nodes above the given depth are pieces on their own.
+	 */
+	static void partition(Node * node, int depth, std::vector<std::pair<Node *, bool>>& pieces);
+	/**
+	 * @brief Returns the depth at which a tree has to be partitioned to have enough pieces for some threads.
+	 * @param threads The number of threads.
+	 */
+	static int partitionDepth(std::size_t threads);
+	/**
+	 * @brief Visits all the nodes of a subtree in key order, without recursion.
+	 * @param top The root of the subtree.
+	 * @param visit Function called on every node.
+	 */
+	template <class TVisit>
+	static void visitSubtree(Node * top, TVisit& visit);
+	/**
+	 * @brief Runs a set of tasks on a pool of threads, each of them repeatedly taking the first task not yet run.
+	 * @param count The number of tasks, identified by the numbers from 0 to count - 1.
+	 * @param task Function called on the number of every task, concurrently.
+	 * @param threads The number of threads, including the calling one.
+	 */
+	template <class TTask>
+	static void parallelRun(std::size_t count, TTask task, std::size_t threads);
+	/**
+	 * @brief Links a sorted array of nodes into a balanced subtree, forking the left halves to new threads.
+	 * @param nodes The nodes in ascending key order.
+	 * @param size The number of nodes.
+	 * @param parent The parent of the resulting subtree.
+	 * @param depth The depth of the resulting subtree.
+	 * @param height The height of the whole tree.
+	 * @param forks The number of levels at which left halves are linked by a new thread.
+	 * @return Node* The root of the resulting subtree, whose data is refreshed.
+	 */
+	Node * parallelLink(Node ** nodes, std::size_t size, Node * parent, int depth, int height, int forks);
+	/**
+	 * @brief Performs a left rotation on every other node of the vine, starting from the root.
+	 * @param count The number of rotations to be performed.
+	 */
+	void compress(std::size_t count);
+	/**
+	 * @brief Recomputes the balancing data of every node of a subtree in which only the last level may be incomplete.
+	 * @param node The root of the subtree.
+	 * @param height The height of the subtree.
+	 * 
+	 * Nodes are visited in post-order through their parent pointers, without recursion.
+	 */
+	void refreshTree(Node * node, int height);
+	/** @brief Overload of refreshNode for trees without balancing data. */
+	void refreshNode(Node *, int, int, NoBalancing) {}
+	/** @brief Overload of refreshNode for AVL trees, children heights are already refreshed. */
+	void refreshNode(Node * node, int, int, AVLBalancing) { updateNode(node); }
+	/** @brief Overload of refreshNode for red-black trees, only the nodes of the last level are red. */
+	void refreshNode(Node * node, int depth, int height, RedBlackBalancing) { node->red = depth > 0 && depth == height - 1; }
 	/**
 	 * @brief Utility function of printTree, prints the value of a node.
 	 * @param node The node to be printed.
 	 * @param os THe stream to which the value should be printed.
 	 */
-	void printNode(const std::unique_ptr<Node>& node, std::ostream& os) const;
+	void printNode(const NodePtr& node, std::ostream& os) const;
 	/**
 	 * @brief Utility function of printTree, recursively prints the tree structure.
 	 * @param node The value of the node to be printed next.
@@ -76,7 +426,21 @@ private:
 	 * @param right If the branch is a right or a left one, for formatting purposes.
 	 * @param indent Specifies the indent of the current branch.
 	 */
-	void printTreeStructure(const std::unique_ptr<Node>& node, std::ostream& os, bool right, std::string indent) const;
+	void printTreeStructure(const NodePtr& node, std::ostream& os, bool right, std::string indent) const;
+	/** @brief Overload of verifySubtree for unbalanced trees, which have no invariant to check. */
+	int verifySubtree(const Node *, NoBalancing) const { return 0; }
+	/**
+	 * @brief Utility function of verify, recursively checks the AVL invariants of a subtree.
+	 * @param node The root of the subtree.
+	 * @return int The height of the subtree, -1 if a stored height is wrong or a balance factor is greater than one.
+	 */
+	int verifySubtree(const Node * node, AVLBalancing) const;
+	/**
+	 * @brief Utility function of verify, recursively checks the red-black invariants of a subtree.
+	 * @param node The root of the subtree.
+	 * @return int The black height of the subtree, -1 if a red node has a red child or the black heights of two siblings differ.
+	 */
+	int verifySubtree(const Node * node, RedBlackBalancing) const;
 
 public:
 	/**
@@ -88,19 +452,38 @@ public:
 	 * @param d The key,value pair for root node.
 	 * @param c The custom comparison function for tree nodes, not mandatory.
 	 */
-	BinarySearchTree(std::pair<TKey, TValue> d, TCompare c = TCompare{}): root{new Node{d}}, compare{c} {}
+	BinarySearchTree(std::pair<TKey, TValue> d, TCompare c = TCompare{}): compare{c} { insert(d); }
+	/**
+	 * @brief Constructor for binary search tree from a range sorted by key.
+	 * @param first The iterator to the first key,value pair of the range.
+	 * @param last The iterator past the last key,value pair of the range.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 * 
+	 * The tree is built in O(n) using the assign method.
+	 */
+	template <class TInputIterator>
+	BinarySearchTree(TInputIterator first, TInputIterator last, TCompare c = TCompare{}) : compare{c} { assign(first, last); }
 	/**
 	 * @brief Copy constructor for binary search tree.
 	 * @param bst The binary search tree to be copied into a new one.
 	 * 
 	 * The method performs a deep copy of the tree using the copy private method.
 	 */
-	BinarySearchTree(const BinarySearchTree& bst) { copy(bst.root); }
+	BinarySearchTree(const BinarySearchTree& bst) : autoBalanceFactor{bst.autoBalanceFactor}, compare{bst.compare} { copy(bst.root); }
 	/**
 	 * @brief Move constructor for binary search tree.
 	 * @param bst The binary search tree to be moved into a new one.
 	 */
-	BinarySearchTree(BinarySearchTree&& bst) noexcept : root{std::move(bst.root)} {}
+	BinarySearchTree(BinarySearchTree&& bst) noexcept : nodeArena{std::move(bst.nodeArena)}, root{std::move(bst.root)},
+		rightmost{bst.rightmost}, nodeCount{bst.nodeCount}, autoBalanceFactor{bst.autoBalanceFactor}, compare{std::move(bst.compare)}
+	{
+		bst.rightmost = nullptr;
+		bst.nodeCount = 0;
+	}
+	/**
+	 * @brief Destructor for binary search tree, releases the nodes using clear().
+	 */
+	~BinarySearchTree() { clear(); }
 	/**
 	 * @brief Insert a new node in the binary search tree.
 	 * @param d The key,value pair to be inserted.
@@ -109,12 +492,82 @@ public:
 	 * If a node with the same key is already present inside the tree, the insert operation
 	 * will simply return false without performing any action. This design choice has been
 	 * taken in order to keep the implementation as simple as possible.
+	 * After the insertion the tree is rebalanced according to the TBalance policy.
 	 */
-	bool insert(std::pair<TKey, TValue> d);
+	bool insert(const std::pair<TKey, TValue>& d) { return insertUnique(d.first, d).second; }
+	/**
+	 * @brief Insert a new node in the binary search tree, moving the pair into it.
+	 * @param d The key,value pair to be inserted.
+	 * @return True if the insert operation is successful, else false.
+	 * 
+	 * The pair is left untouched if a node with the same key is already present.
+	 */
+	bool insert(std::pair<TKey, TValue>&& d) { return insertUnique(d.first, std::move(d)).second; }
+	/**
+	 * @brief Insert a new node in the binary search tree, building its key,value pair in place.
+	 * @param args The arguments forwarded to the constructor of the key,value pair.
+	 * @return std::pair<Iterator, bool> An iterator to the node with the key, and true if it was inserted.
+	 * 
+	 * The pair is built before the search in order to know its key, then moved into the node.
+	 */
+	template <class... TArgs>
+	std::pair<Iterator, bool> emplace(TArgs&&... args);
+	/**
+	 * @brief Insert a new node if the key is not present, building its value in place.
+	 * @param key The key of the node to be inserted.
+	 * @param args The arguments forwarded to the constructor of the value.
+	 * @return std::pair<Iterator, bool> An iterator to the node with the key, and true if it was inserted.
+	 * 
+	 * Unlike emplace, nothing is built or moved if the key is already present.
+	 */
+	template <class... TArgs>
+	std::pair<Iterator, bool> try_emplace(const TKey& key, TArgs&&... args)
+	{
+		return insertUnique(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<TArgs>(args)...));
+	}
+	/**
+	 * @brief Insert a new node if the key is not present, moving the key and building its value in place.
+	 * @param key The key of the node to be inserted.
+	 * @param args The arguments forwarded to the constructor of the value.
+	 * @return std::pair<Iterator, bool> An iterator to the node with the key, and true if it was inserted.
+	 */
+	template <class... TArgs>
+	std::pair<Iterator, bool> try_emplace(TKey&& key, TArgs&&... args)
+	{
+		return insertUnique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<TArgs>(args)...));
+	}
+	/**
+	 * @brief Insert a new node in the binary search tree, as close as possible to a hint.
+	 * @param hint An iterator to the element that should follow the new one.
+	 * @param d The key,value pair to be inserted.
+	 * @return Iterator An iterator to the inserted element, or to the element with the same key.
+	 * 
+	 * If the new element belongs right before the hint, or right after it, no search
+	 * is performed: appending keys in ascending order with end() as hint, or with the
+	 * iterator returned by the previous insertion, is amortized O(1) before rebalancing.
+	 * Otherwise, the hint is ignored and the element is inserted as usual.
+	 */
+	Iterator insert(Iterator hint, std::pair<TKey, TValue> d);
+	/**
+	 * @brief Replaces the content of the tree with the elements of a range sorted by key.
+	 * @param first The iterator to the first key,value pair of the range.
+	 * @param last The iterator past the last key,value pair of the range.
+	 * 
+	 * The elements are linked into a vine in O(n), whose nodes are then relinked
+	 * into a balanced tree in a single ordered pass. Elements whose key is not
+	 * greater than the key of the previous element are skipped.
+	 */
+	template <class TInputIterator>
+	void assign(TInputIterator first, TInputIterator last);
 	/**
 	 * @brief Clears all the elements of the tree
+	 * 
+	 * Nodes are destroyed iteratively by rotating the left children of the root up,
+	 * so the stack usage doesn't depend on the height of the tree.
+	 * With a pool allocation policy the memory of all nodes is released in one go,
+	 * skipping the nodes traversal if keys and values are trivially destructible.
 	 */
-	void clear() { root.reset(); }
+	void clear();
 	/**
 	 * @brief Prints nodes in ascending key order.
 	 * @param os The stream to which nodes are sent.
@@ -125,20 +578,222 @@ public:
 	 * @param os The stream to which the nodes are sent.
 	 */
 	std::ostream& printTree(std::ostream& os) const;
+	/**
+	 * @brief Checks the invariants of the balancing policy and the parent pointers, walking the whole tree.
+	 * @return True if the tree is correctly balanced, else false. Unbalanced trees are always valid.
+	 */
+	bool verify() const { return verifySubtree(root.get(), TBalance{}) >= 0; }
 	/**
 	 * @brief Used to find a node inside the tree.
 	 * @param key The key of the node to be found.
 	 * @return Iterator An iterator to the node if it's found, else to end().
+	 * 
+	 * Keys are matched when they are equivalent according to TCompare.
+	 */
+	Iterator find(const TKey& key) const { return findEquivalent(key); }
+	/**
+	 * @brief Used to find a node inside the tree with a key of a different type.
+	 * @param key A key comparable with TKey, e.g. a std::string_view for std::string keys.
+	 * @return Iterator An iterator to the node if it's found, else to end().
+	 * 
+	 * Only available if TCompare is transparent (e.g. std::less<>), so that no TKey is built.
+	 */
+	template <class TKeyArg, class TComp = TCompare, class = typename TComp::is_transparent>
+	Iterator find(const TKeyArg& key) const { return findEquivalent(key); }
+	/**
+	 * @brief Used to find many nodes inside the tree at once.
+	 * @param first The iterator to the first key to be found.
+	 * @param last The iterator past the last key to be found.
+	 * @param out The output iterator to which an Iterator is written for every key,
+	 * pointing to the node if it's found, else to end().
+	 * 
+	 * Keys are processed in groups of batchSize, whose traversals are advanced in
+	 * lockstep one level at a time. The next node of every traversal is prefetched,
+	 * so that the cache misses of the whole group are served in parallel.
+	 */
+	template <class TForwardIterator, class TOutputIterator>
+	void find_many(TForwardIterator first, TForwardIterator last, TOutputIterator out) const;
+	/** Number of traversals advanced in lockstep by find_many. */
+	static constexpr std::size_t batchSize = 16;
+	/**
+	 * @brief Finds the first node whose key is not less than a key.
+	 * @param key The key to be compared.
+	 * @return Iterator An iterator to the node, or end() if all keys are less than key.
+	 */
+	Iterator lower_bound(const TKey& key) const;
+	/**
+	 * @brief Finds the first node whose key is greater than a key.
+	 * @param key The key to be compared.
+	 * @return Iterator An iterator to the node, or end() if no key is greater than key.
+	 */
+	Iterator upper_bound(const TKey& key) const;
+	/**
+	 * @brief Finds the range of nodes whose key is equivalent to a key.
+	 * @param key The key to be compared.
+	 * @return std::pair<Iterator, Iterator> The lower_bound and upper_bound of the key.
+	 */
+	std::pair<Iterator, Iterator> equal_range(const TKey& key) const { return {lower_bound(key), upper_bound(key)}; }
+	/**
+	 * @brief Counts the nodes whose key is less than a key, in O(log n).
+	 * @param key The key to be compared.
+	 * @return std::size_t The number of keys less than key, which is the position key would have in the tree.
+	 * 
+	 * Requires the OrderStatistics augmentation policy.
+	 */
+	std::size_t rank(const TKey& key) const;
+	/**
+	 * @brief Finds the node in a given position in ascending key order, in O(log n).
+	 * @param k The position of the node, starting from 0.
+	 * @return Iterator An iterator to the node, or end() if k is not less than the size of the tree.
+	 * 
+	 * Requires the OrderStatistics augmentation policy.
+	 */
+	Iterator select(std::size_t k) const;
+	/**
+	 * @brief Counts the nodes whose key is in the range [first, last), in O(log n).
+	 * @param first The lowest key of the range.
+	 * @param last The key past the range.
+	 * @return std::size_t The number of keys in the range, 0 if last is not greater than first.
+	 * 
+	 * Requires the OrderStatistics augmentation policy.
 	 */
-	Iterator find(TKey key) const;
+	std::size_t count_range(const TKey& first, const TKey& last) const { return compare(first, last) ? rank(last) - rank(first) : 0; }
 	/**
 	 * @brief Balances the tree to preserve its performances.
 	 * 
-	 * The method is inspired from the Day algorithm, taking full
-	 * advantage of the iterators and the methods we already created
-	 * to make it as simple as possible.
+	 * The method implements the Day-Stout-Warren algorithm, which relinks the
+	 * existing nodes in place through rotations in O(n) time, without
+	 * allocations nor key comparisons.
 	 */
 	void balance();
+	/**
+	 * @brief Returns the number of nodes of the tree, in constant time.
+	 */
+	std::size_t size() const { return nodeCount; }
+	/**
+	 * @brief Computes statistics on the shape of the tree, visiting all its nodes.
+	 * @return Statistics The size, height, average and maximum depth and depth histogram of the tree.
+	 */
+	Statistics stats() const;
+	/**
+	 * @brief Returns the current values of the operation counters.
+	 * @return Counters The counters, all zero unless BSTCOUNTERS is defined at compile time.
+	 */
+	Counters counters() const;
+	/**
+	 * @brief Resets all the operation counters to zero.
+	 */
+	void reset_counters();
+	/**
+	 * @brief Sets the threshold above which the tree is balanced automatically on insertion.
+	 * @param factor Multiple of the optimal height, log2(size), that a new node can't exceed. Default 0, disabled.
+	 * 
+	 * When the depth of an inserted node exceeds the threshold, the subtree of its lowest ancestor
+	 * too unbalanced by size is rebuilt, as in scapegoat trees, keeping insertions O(log n) amortized
+	 * even for sorted elements. AVL and red-black trees are balanced as a whole instead, at most once
+	 * every n/2 insertions. The depth is only measured if the threshold is enabled, otherwise insertions
+	 * are not affected. Factors should be greater than 1, larger ones trade lookup speed for less frequent rebuilds.
+	 */
+	void auto_balance(double factor) { autoBalanceFactor = factor; }
+	/**
+	 * @brief Moves all the nodes of another tree into this one, in O(n + m) without allocations.
+	 * @param other The tree whose nodes are moved, left empty.
+	 * 
+	 * The nodes of both trees are merged in order and relinked into a balanced tree.
+	 * Nodes of other whose key is already present in this tree are destroyed.
+	 */
+	void merge(BinarySearchTree&& other);
+	/**
+	 * @brief Splits the tree in two around a key, in O(n) without allocations.
+	 * @param key The lowest key moved to the returned tree.
+	 * @return BinarySearchTree A balanced tree with the nodes whose key is not less than key.
+	 * 
+	 * This tree keeps the nodes whose key is less than key, and is balanced as well.
+	 */
+	BinarySearchTree split(const TKey& key);
+	/**
+	 * @brief Appends all the nodes of another tree to this one, in O(n + m) without allocations nor key comparisons.
+	 * @param other The tree whose nodes are moved, left empty.
+	 * @throw std::invalid_argument If the keys of other are not all greater than the keys of this tree.
+	 * 
+	 * The result is balanced. It is the inverse operation of split.
+	 */
+	void join(BinarySearchTree&& other);
+	/**
+	 * @brief Computes the union of two trees in O(n + m), merging them in order.
+	 * @param other The other tree.
+	 * @return BinarySearchTree A new balanced tree with the keys of both trees, keeping the values of this tree for common keys.
+	 */
+	BinarySearchTree set_union(const BinarySearchTree& other) const { return combine<true, true, true>(other); }
+	/**
+	 * @brief Computes the intersection of two trees in O(n + m), merging them in order.
+	 * @param other The other tree.
+	 * @return BinarySearchTree A new balanced tree with the keys present in both trees and the values of this tree.
+	 */
+	BinarySearchTree set_intersection(const BinarySearchTree& other) const { return combine<false, true, false>(other); }
+	/**
+	 * @brief Computes the difference of two trees in O(n + m), merging them in order.
+	 * @param other The other tree.
+	 * @return BinarySearchTree A new balanced tree with the elements of this tree whose key is not present in other.
+	 */
+	BinarySearchTree set_difference(const BinarySearchTree& other) const { return combine<true, false, false>(other); }
+	/**
+	 * @brief Balances the tree using multiple threads.
+	 * @param threads The number of threads to be used. Default the number of hardware threads.
+	 * 
+	 * The nodes are collected in order into a temporary array by disjoint subtrees,
+	 * then relinked by median with the two halves of every subtree linked in parallel
+	 * down to a depth depending on the number of threads. Unlike balance(), it needs
+	 * memory for one pointer per node.
+	 */
+	void parallel_balance(std::size_t threads = std::thread::hardware_concurrency());
+	/**
+	 * @brief Calls a function on all the elements of the tree using multiple threads.
+	 * @param visit Function called on every key,value pair, concurrently and in no particular order.
+	 * @param threads The number of threads to be used. Default the number of hardware threads.
+	 * 
+	 * Work is split by subtree, so it is evenly spread between threads only on balanced trees.
+	 */
+	template <class TVisit>
+	void parallel_for_each(TVisit visit, std::size_t threads = std::thread::hardware_concurrency());
+	/**
+	 * @brief Reduces all the elements of the tree to a single result using multiple threads.
+	 * @param identity The initial result of every thread.
+	 * @param accumulate Function adding a constant key,value pair to a result, returning the new result.
+	 * @param combine Associative function combining two results, the first one coming from lower keys.
+	 * @param threads The number of threads to be used. Default the number of hardware threads.
+	 * @return T The combined result of all the elements, in key order.
+	 * 
+	 * Both functions may be called concurrently. Work is split by subtree, so it is
+	 * evenly spread between threads only on balanced trees.
+	 */
+	template <class T, class TAccumulate, class TCombine>
+	T parallel_reduce(T identity, TAccumulate accumulate, TCombine combine, std::size_t threads = std::thread::hardware_concurrency()) const;
+	/**
+	 * @brief Creates an immutable read-optimized snapshot of the tree.
+	 * @return FrozenBinarySearchTree<TKey, TValue, TCompare> The snapshot, with keys and values in Eytzinger order.
+	 */
+	FrozenBinarySearchTree<TKey, TValue, TCompare> freeze() const { return FrozenBinarySearchTree<TKey, TValue, TCompare>{cbegin(), cend(), compare}; }
+	/**
+	 * @brief Writes a binary snapshot of the tree, in O(n) time.
+	 * @param os The binary stream to which the snapshot is written.
+	 * @throw std::runtime_error If the stream fails.
+	 * 
+	 * Keys and values must be trivially copyable or strings. Trivially copyable ones are
+	 * written as arrays in native byte order, which MappedBinarySearchTree can search in place.
+	 * The format is described in BinarySearchTreeSnapshot.h.
+	 */
+	void save(std::ostream& os) const;
+	/**
+	 * @brief Replaces the elements of the tree with a binary snapshot written by save, in O(n) time.
+	 * @param is The binary stream from which the snapshot is read.
+	 * @throw std::runtime_error If the snapshot is truncated, corrupted, not sorted or written for other types.
+	 * 
+	 * The nodes are appended in order and linked into a balanced tree, as in assign(), which
+	 * is built aside and then moved into this one. Keys and values must be default constructible.
+	 * If an exception is thrown, even while creating the nodes, the tree is left unchanged.
+	 */
+	void load(std::istream& is);
 	/**
 	 * @brief Used to begin an iteration on the binary search tree.
 	 * @return Iterator An iterator to the leftmost node of the tree. 
@@ -181,12 +836,21 @@ public:
 	 * @brief Operator [] to access a node value in the tree or insert a new one.
 	 * @param key The key of the node which value should be accessed.
 	 * @return TValue& The value of the accessed node.
+	 * 
+	 * A single traversal is performed, and no value is built if the key is present.
+	 */
+	TValue& operator[](const TKey& key) { return (*try_emplace(key).first).second; }
+	/**
+	 * @brief Operator [] to access a node value in the tree or insert a new one, moving the key.
+	 * @param key The key of the node which value should be accessed.
+	 * @return TValue& The value of the accessed node.
 	 */
-	TValue& operator[](const TKey& key);
+	TValue& operator[](TKey&& key) { return (*try_emplace(std::move(key)).first).second; }
 	/**
-	 * @brief Constant implementation of operator [] to access a node value in the tree or insert a new one.
+	 * @brief Constant implementation of operator [] to access a node value in the tree.
 	 * @param key The key of the node which value should be accessed.
 	 * @return TValue& The value of the accessed node.
+	 * @throw std::out_of_range If the key is not present in the tree.
 	 */
 	const TValue& operator[](const TKey& key) const;
 	/**
@@ -9,12 +9,15 @@
 
 // Private Methods
 
-template <class TKey,class TValue,class TCompare>
-typename BinarySearchTree<TKey, TValue, TCompare>::Iterator BinarySearchTree<TKey, TValue, TCompare>::findNearest(const TKey& key) const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class TKeyArg>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::findNearest(const TKeyArg& key) const
 {
     Node * node = root.get();
     while(node)
     {
+        BST_COUNT(visitedNodes, 1);
+        BST_COUNT(comparisons, 1);
         if(compare(node->data.first, key))
         {
             if(!node->right) // Node was not found
@@ -23,7 +26,7 @@ typename BinarySearchTree<TKey, TValue, TCompare>::Iterator BinarySearchTree<TKe
             }
             node = node->right.get();
         }
-        else if (compare(key, node->data.first))
+        else if (BST_COUNT(comparisons, 1), compare(key, node->data.first))
         {
             if(!node->left) // Node was not found
             {
@@ -39,38 +42,747 @@ typename BinarySearchTree<TKey, TValue, TCompare>::Iterator BinarySearchTree<TKe
     return end(); // Tree is empty
 }
 
-template <class TKey,class TValue,class TCompare>
-void BinarySearchTree<TKey, TValue, TCompare>::copy(const std::unique_ptr<Node>& node)
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::copy(const NodePtr& node)
 {
-    if(node)
+    if(!node)
     {
-        insert(node->data);
-        copy(node->left);
-        copy(node->right);
+        return;
+    }
+    BST_COUNT(allocations, 1);
+    nodeCount = 1;
+    root.reset(nodeArena.create(*node));
+    root->parent = nullptr;
+    const Node * source = node.get();
+    Node * target = root.get();
+    while(target)
+    {
+        if(source->left && !target->left) // Left subtree still to be copied
+        {
+            BST_COUNT(allocations, 1);
+            ++nodeCount;
+            target->left.reset(nodeArena.create(*source->left));
+            target->left->parent = target;
+            source = source->left.get();
+            target = target->left.get();
+        }
+        else if(source->right && !target->right) // Right subtree still to be copied
+        {
+            BST_COUNT(allocations, 1);
+            ++nodeCount;
+            target->right.reset(nodeArena.create(*source->right));
+            target->right->parent = target;
+            source = source->right.get();
+            target = target->right.get();
+        }
+        else // Both subtrees copied, back to the parent
+        {
+            source = source->parent;
+            target = target->parent;
+        }
+    }
+    rightmost = root.get();
+    while(rightmost->right)
+    {
+        rightmost = rightmost->right.get();
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class... TArgs>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Node * BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::attach(Node * parent, bool right, TArgs&&... args)
+{
+    Node * node = nodeArena.create(parent, std::forward<TArgs>(args)...);
+    BST_COUNT(inserts, 1);
+    BST_COUNT(allocations, 1);
+    ++nodeCount;
+    if(!parent)
+    {
+        root.reset(node);
+    }
+    else if(right)
+    {
+        parent->right.reset(node);
+    }
+    else
+    {
+        parent->left.reset(node);
+    }
+    if(parent == rightmost && (right || !parent))
+    {
+        rightmost = node;
+    }
+    updateAncestors(node, TAugmentation{});
+    rebalance(node);
+    if(autoBalanceFactor > 0)
+    {
+        autoBalance(node);
+    }
+    return node;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::autoBalance(Node * node)
+{
+    int depth = 1;
+    for(const Node * ancestor = node; ancestor->parent; ancestor = ancestor->parent)
+    {
+        ++depth;
+    }
+    int optimalHeight = 0;
+    for(std::size_t size = nodeCount; size; size >>= 1)
+    {
+        ++optimalHeight;
+    }
+    ++autoBalanceInserts;
+    if(depth > autoBalanceFactor * optimalHeight)
+    {
+        autoRebuild(node, TBalance{});
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::autoRebuild(Node * node, NoBalancing)
+{
+    double alpha = std::pow(2.0, -1.0 / autoBalanceFactor);
+    std::size_t size = 1; // The inserted node is a leaf
+    for(Node * parent = node->parent; parent; node = parent, parent = parent->parent)
+    {
+        Node * sibling = parent->left.get() == node ? parent->right.get() : parent->left.get();
+        std::size_t parentSize = size + 1 + countNodes(sibling);
+        if(size > alpha * parentSize) // Scapegoat found
+        {
+            BST_COUNT(autoBalances, 1);
+            rebuildSubtree(parent, parentSize);
+            return;
+        }
+        size = parentSize;
+    }
+    BST_COUNT(autoBalances, 1);
+    rebuildSubtree(root.get(), size);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::autoRebuildTree()
+{
+    if(autoBalanceInserts >= nodeCount / 2)
+    {
+        BST_COUNT(autoBalances, 1);
+        autoBalanceInserts = 0;
+        balance();
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+std::size_t BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::countNodes(const Node * node)
+{
+    if(!node)
+    {
+        return 0;
+    }
+    const Node * top = node;
+    std::size_t count = 1;
+    while(true) // Pre-order visit through the parent pointers
+    {
+        if(node->left || node->right)
+        {
+            node = node->left ? node->left.get() : node->right.get();
+            ++count;
+            continue;
+        }
+        while(node != top && (node == node->parent->right.get() || !node->parent->right))
+        {
+            node = node->parent;
+        }
+        if(node == top)
+        {
+            return count;
+        }
+        node = node->parent->right.get();
+        ++count;
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::rebuildSubtree(Node * node, std::size_t size)
+{
+    Node * parent = node->parent;
+    NodePtr& owner{ownerOf(node)};
+    NodePtr vine{std::move(owner)};
+    NodePtr * link = &vine;
+    while(*link) // Right rotations turn the subtree into a vine, parent pointers are restored by linkVine
+    {
+        Node * top = link->get();
+        if(top->left)
+        {
+            NodePtr left{std::move(top->left)};
+            top->left = std::move(left->right);
+            left->right = std::move(*link);
+            *link = std::move(left);
+        }
+        else
+        {
+            link = &top->right;
+        }
+    }
+    owner = linkVine(vine, size, parent);
+    int height = 0;
+    for(; size; size >>= 1)
+    {
+        ++height;
+    }
+    refreshTree(owner.get(), height);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::NodePtr& BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::ownerOf(Node * node)
+{
+    if(!node->parent)
+    {
+        return root;
+    }
+    return node->parent->left.get() == node ? node->parent->left : node->parent->right;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::rotateLeft(Node * node)
+{
+    NodePtr& owner{ownerOf(node)};
+    NodePtr child{std::move(node->right)};
+    node->right = std::move(child->left);
+    if(node->right)
+    {
+        node->right->parent = node;
+    }
+    child->parent = node->parent;
+    node->parent = child.get();
+    child->left = std::move(owner); // owner was pointing to node
+    owner = std::move(child);
+    updateNode(node);
+    updateNode(node->parent);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::rotateRight(Node * node)
+{
+    NodePtr& owner{ownerOf(node)};
+    NodePtr child{std::move(node->left)};
+    node->left = std::move(child->right);
+    if(node->left)
+    {
+        node->left->parent = node;
+    }
+    child->parent = node->parent;
+    node->parent = child.get();
+    child->right = std::move(owner); // owner was pointing to node
+    owner = std::move(child);
+    updateNode(node);
+    updateNode(node->parent);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::updateAncestors(Node * node, OrderStatistics)
+{
+    for(node = node->parent; node; node = node->parent)
+    {
+        ++node->size;
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::updateNode(Node * node, AVLBalancing)
+{
+    int leftHeight = node->left ? node->left->height : 0;
+    int rightHeight = node->right ? node->right->height : 0;
+    node->height = 1 + std::max(leftHeight, rightHeight);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::rebalance(Node * node, AVLBalancing)
+{
+    auto height = [](const NodePtr& n) { return n ? n->height : 0; };
+    for(node = node->parent; node; node = node->parent)
+    {
+        int oldHeight = node->height;
+        updateNode(node);
+        int balanceFactor = height(node->left) - height(node->right);
+        if(balanceFactor > 1) // Left heavy
+        {
+            if(height(node->left->left) < height(node->left->right))
+            {
+                rotateLeft(node->left.get());
+            }
+            rotateRight(node);
+            return; // A rotation restores the height the subtree had before the insertion
+        }
+        else if(balanceFactor < -1) // Right heavy
+        {
+            if(height(node->right->right) < height(node->right->left))
+            {
+                rotateRight(node->right.get());
+            }
+            rotateLeft(node);
+            return;
+        }
+        if(node->height == oldHeight) // Ancestors are not affected
+        {
+            return;
+        }
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::rebalance(Node * node, RedBlackBalancing)
+{
+    auto isRed = [](const Node * n) { return n && n->red; };
+    while(isRed(node->parent))
+    {
+        Node * parent = node->parent;
+        Node * grandParent = parent->parent; // Always present since the root is black
+        if(parent == grandParent->left.get())
+        {
+            Node * uncle = grandParent->right.get();
+            if(isRed(uncle))
+            {
+                parent->red = false;
+                uncle->red = false;
+                grandParent->red = true;
+                node = grandParent;
+                continue;
+            }
+            if(node == parent->right.get())
+            {
+                node = parent;
+                rotateLeft(node);
+                parent = node->parent;
+            }
+            parent->red = false;
+            grandParent->red = true;
+            rotateRight(grandParent);
+        }
+        else
+        {
+            Node * uncle = grandParent->left.get();
+            if(isRed(uncle))
+            {
+                parent->red = false;
+                uncle->red = false;
+                grandParent->red = true;
+                node = grandParent;
+                continue;
+            }
+            if(node == parent->left.get())
+            {
+                node = parent;
+                rotateRight(node);
+                parent = node->parent;
+            }
+            parent->red = false;
+            grandParent->red = true;
+            rotateLeft(grandParent);
+        }
+    }
+    root->red = false;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+std::size_t BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::treeToVine()
+{
+    std::size_t size = 0;
+    Node * node = root.get();
+    while(node)
+    {
+        if(node->left)
+        {
+            rotateRight(node);
+            node = node->parent; // The left child took the place of the node
+        }
+        else
+        {
+            ++size;
+            node = node->right.get();
+        }
+    }
+    return size;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::vineToTree(std::size_t size)
+{
+    int height = 0;
+    std::size_t fullSize = 1; // Largest power of two not greater than size + 1
+    for(std::size_t s = size; s; s >>= 1)
+    {
+        ++height;
+    }
+    while(fullSize <= (size + 1) / 2)
+    {
+        fullSize *= 2;
+    }
+    std::size_t leaves = size + 1 - fullSize; // Nodes in the last incomplete level
+    compress(leaves);
+    size -= leaves;
+    while(size > 1)
+    {
+        size /= 2;
+        compress(size);
+    }
+    refreshTree(root.get(), height);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::NodePtr BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::linkVine(NodePtr& vine, std::size_t size, Node * parent)
+{
+    if(!size)
+    {
+        return NodePtr{};
+    }
+    std::size_t leftSize = (size - 1) / 2;
+    NodePtr left{linkVine(vine, leftSize, nullptr)};
+    NodePtr node{std::move(vine)};
+    vine = std::move(node->right);
+    node->parent = parent;
+    if(left)
+    {
+        left->parent = node.get();
+    }
+    node->left = std::move(left);
+    node->right = linkVine(vine, size - 1 - leftSize, node.get());
+    return node;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class... TArgs>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::appendToVine(TArgs&&... args)
+{
+    Node * node = nodeArena.create(rightmost, std::forward<TArgs>(args)...);
+    BST_COUNT(allocations, 1);
+    if(rightmost)
+    {
+        rightmost->right.reset(node);
+    }
+    else
+    {
+        root.reset(node);
+    }
+    rightmost = node;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::linkTree(std::size_t size)
+{
+    nodeCount = size;
+    if(!root)
+    {
+        rightmost = nullptr;
+        return;
+    }
+    NodePtr vine{std::move(root)};
+    root = linkVine(vine, size, nullptr);
+    int height = 0;
+    for(; size; size >>= 1)
+    {
+        ++height;
+    }
+    refreshTree(root.get(), height);
+    rightmost = root.get();
+    while(rightmost->right)
+    {
+        rightmost = rightmost->right.get();
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <bool TLeft, bool TBoth, bool TRight>
+BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation> BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::combine(const BinarySearchTree& other) const
+{
+    BinarySearchTree result;
+    result.compare = compare;
+    std::size_t size = 0;
+    ConstIterator left{cbegin()};
+    ConstIterator right{other.cbegin()};
+    while(left != cend() || right != other.cend())
+    {
+        if(right == other.cend() || (left != cend() && compare((*left).first, (*right).first)))
+        {
+            if(TLeft)
+            {
+                result.appendToVine(*left);
+                ++size;
+            }
+            ++left;
+        }
+        else if(left == cend() || compare((*right).first, (*left).first))
+        {
+            if(TRight)
+            {
+                result.appendToVine(*right);
+                ++size;
+            }
+            ++right;
+        }
+        else // Key present in both trees
+        {
+            if(TBoth)
+            {
+                result.appendToVine(*left);
+                ++size;
+            }
+            ++left;
+            ++right;
+        }
+    }
+    result.linkTree(size);
+    return result;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class T, class TField>
+std::uint64_t BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::saveSection(std::ostream& os, std::uint64_t& checksum, TField field) const
+{
+    std::uint64_t bytes = 0;
+    auto write = [&](const char * data, std::size_t size)
+    {
+        os.write(data, size);
+        checksum = SnapshotFormat::checksum(checksum, data, size);
+        bytes += size;
+    };
+    if constexpr(std::is_trivially_copyable<T>::value)
+    {
+        constexpr std::size_t block = 4096; // Fields are gathered in blocks, to be written with few stream calls
+        std::vector<T> buffer;
+        buffer.reserve(block);
+        for(ConstIterator it{cbegin()}; it != cend(); ++it)
+        {
+            buffer.push_back(field(*it));
+            if(buffer.size() == block)
+            {
+                write(reinterpret_cast<const char *>(buffer.data()), buffer.size() * sizeof(T));
+                buffer.clear();
+            }
+        }
+        write(reinterpret_cast<const char *>(buffer.data()), buffer.size() * sizeof(T));
+    }
+    else // Strings, preceded by their length
+    {
+        for(ConstIterator it{cbegin()}; it != cend(); ++it)
+        {
+            const T& string = field(*it);
+            std::uint64_t length = string.size();
+            write(reinterpret_cast<const char *>(&length), sizeof(length));
+            write(reinterpret_cast<const char *>(string.data()), length * sizeof(typename T::value_type));
+        }
+    }
+    return bytes;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class T>
+std::vector<T> BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::loadSection(std::istream& is, std::uint64_t& checksum, std::uint64_t count, std::uint64_t& offset)
+{
+    auto read = [&](char * data, std::size_t size)
+    {
+        if(!is.read(data, size))
+        {
+            throw std::runtime_error{"The snapshot is truncated."};
+        }
+        checksum = SnapshotFormat::checksum(checksum, data, size);
+        offset += size;
+    };
+    constexpr std::uint64_t block = 4096;
+    std::vector<T> fields;
+    if constexpr(std::is_trivially_copyable<T>::value)
+    {
+        while(fields.size() < count)
+        {
+            std::size_t size = fields.size();
+            fields.resize(size + std::min(block, count - size));
+            read(reinterpret_cast<char *>(fields.data() + size), (fields.size() - size) * sizeof(T));
+        }
+    }
+    else // Strings, preceded by their length
+    {
+        for(std::uint64_t i = 0; i < count; ++i)
+        {
+            std::uint64_t length;
+            read(reinterpret_cast<char *>(&length), sizeof(length));
+            T string;
+            while(string.size() < length)
+            {
+                std::size_t size = string.size();
+                string.resize(size + std::min(block, length - size));
+                read(reinterpret_cast<char *>(&string[size]), (string.size() - size) * sizeof(typename T::value_type));
+            }
+            fields.push_back(std::move(string));
+        }
+    }
+    return fields;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::partition(Node * node, int depth, std::vector<std::pair<Node *, bool>>& pieces)
+{
+    if(!node)
+    {
+        return;
+    }
+    if(!depth)
+    {
+        pieces.emplace_back(node, true);
+        return;
+    }
+    partition(node->left.get(), depth - 1, pieces);
+    pieces.emplace_back(node, false);
+    partition(node->right.get(), depth - 1, pieces);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+int BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::partitionDepth(std::size_t threads)
+{
+    int depth = 3; // About eight subtrees per thread, so that faster threads can take more of them
+    for(; threads > 1; threads = (threads + 1) / 2)
+    {
+        ++depth;
+    }
+    return depth;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class TVisit>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::visitSubtree(Node * top, TVisit& visit)
+{
+    Node * node = top;
+    while(node->left)
+    {
+        node = node->left.get();
+    }
+    while(true)
+    {
+        visit(node);
+        if(node->right) // Leftmost node of the right subtree
+        {
+            node = node->right.get();
+            while(node->left)
+            {
+                node = node->left.get();
+            }
+        }
+        else // First ancestor of which the node is in the left subtree, unless it is above top
+        {
+            while(node != top && node == node->parent->right.get())
+            {
+                node = node->parent;
+            }
+            if(node == top)
+            {
+                return;
+            }
+            node = node->parent;
+        }
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class TTask>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::parallelRun(std::size_t count, TTask task, std::size_t threads)
+{
+    std::atomic<std::size_t> next{0};
+    auto worker = [&next, &task, count]()
+    {
+        for(std::size_t id = next++; id < count; id = next++)
+        {
+            task(id);
+        }
+    };
+    std::vector<std::future<void>> workers;
+    for(std::size_t i = 1; i < std::min(threads, count); ++i)
+    {
+        try
+        {
+            workers.push_back(std::async(std::launch::async, worker));
+        }
+        catch(const std::system_error&)
+        {
+            break; // No more threads available, the remaining workers take the tasks
+        }
+    }
+    worker();
+    for(std::future<void>& w : workers)
+    {
+        w.get();
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Node * BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::parallelLink(Node ** nodes, std::size_t size, Node * parent, int depth, int height, int forks)
+{
+    if(!size)
+    {
+        return nullptr;
+    }
+    std::size_t leftSize = (size - 1) / 2; // Same shape as linkVine
+    Node * node = nodes[leftSize];
+    node->parent = parent;
+    std::future<Node *> left;
+    if(forks > 0)
+    {
+        try
+        {
+            left = std::async(std::launch::async, &BinarySearchTree::parallelLink, this, nodes, leftSize, node, depth + 1, height, forks - 1);
+        }
+        catch(const std::system_error&) {} // Linked by this thread
     }
+    node->right.reset(parallelLink(nodes + leftSize + 1, size - 1 - leftSize, node, depth + 1, height, forks - 1));
+    node->left.reset(left.valid() ? left.get() : parallelLink(nodes, leftSize, node, depth + 1, height, forks - 1));
+    refreshNode(node, depth, height, TBalance{});
+    updateNode(node, TAugmentation{});
+    return node;
 }
 
-template <class TKey,class TValue,class TCompare>
-void BinarySearchTree<TKey, TValue, TCompare>::rebuildBalancedTree(std::vector<std::pair<TKey, TValue>>& nodes, int firstId, int lastId)
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::compress(std::size_t count)
 {
-    if(firstId > lastId)
+    Node * node = root.get();
+    for(std::size_t i = 0; i < count; ++i)
     {
-        return;
+        rotateLeft(node);
+        node = node->parent->right.get();
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::refreshTree(Node * node, int height)
+{
+    Node * end = node->parent;
+    int depth = 0;
+    bool descend = true;
+    while(node != end)
+    {
+        if(descend) // Go down to the first node of the subtree in post-order
+        {
+            while(node->left || node->right)
+            {
+                node = node->left ? node->left.get() : node->right.get();
+                ++depth;
+            }
+        }
+        refreshNode(node, depth, height, TBalance{});
+        updateNode(node, TAugmentation{});
+        Node * parent = node->parent;
+        descend = parent != end && node == parent->left.get() && parent->right;
+        node = descend ? parent->right.get() : parent;
+        depth -= descend ? 0 : 1;
     }
-    int halfId = (firstId + lastId) / 2;
-    insert(nodes[halfId]);
-    rebuildBalancedTree(nodes, firstId, halfId - 1);
-    rebuildBalancedTree(nodes, halfId + 1, lastId);
 }
 
-template <class TKey,class TValue,class TCompare>
-void BinarySearchTree<TKey, TValue, TCompare>::printNode(const std::unique_ptr<Node>& node, std::ostream& os) const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::printNode(const NodePtr& node, std::ostream& os) const
 {
     os << node->data.first << ":" << node->data.second << std::endl;
 }
 
-template <class TKey,class TValue,class TCompare>
-void BinarySearchTree<TKey, TValue, TCompare>::printTreeStructure(const std::unique_ptr<Node>& node, std::ostream& os, bool right, std::string indent) const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::printTreeStructure(const NodePtr& node, std::ostream& os, bool right, std::string indent) const
 {
     if (node->right) 
     {
@@ -84,36 +796,259 @@ void BinarySearchTree<TKey, TValue, TCompare>::printTreeStructure(const std::uni
     }
 }
 
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+int BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::verifySubtree(const Node * node, AVLBalancing) const
+{
+    if(!node)
+    {
+        return 0;
+    }
+    if((node->left && node->left->parent != node) || (node->right && node->right->parent != node))
+    {
+        return -1;
+    }
+    int leftHeight = verifySubtree(node->left.get(), AVLBalancing{});
+    int rightHeight = verifySubtree(node->right.get(), AVLBalancing{});
+    if(leftHeight < 0 || rightHeight < 0 || leftHeight - rightHeight > 1 || rightHeight - leftHeight > 1 || node->height != 1 + std::max(leftHeight, rightHeight))
+    {
+        return -1;
+    }
+    return node->height;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+int BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::verifySubtree(const Node * node, RedBlackBalancing) const
+{
+    if(!node)
+    {
+        return 0; // Empty leaves are black
+    }
+    if((node->left && node->left->parent != node) || (node->right && node->right->parent != node))
+    {
+        return -1;
+    }
+    if(node->red && ((node->left && node->left->red) || (node->right && node->right->red)))
+    {
+        return -1;
+    }
+    int leftBlackHeight = verifySubtree(node->left.get(), RedBlackBalancing{});
+    int rightBlackHeight = verifySubtree(node->right.get(), RedBlackBalancing{});
+    if(leftBlackHeight < 0 || leftBlackHeight != rightBlackHeight)
+    {
+        return -1;
+    }
+    return leftBlackHeight + !node->red;
+}
+
 // Public methods
 
-template <class TKey,class TValue,class TCompare>
-bool BinarySearchTree<TKey, TValue, TCompare>::insert(std::pair<TKey, TValue> d)
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::clear()
 {
-    Iterator nearest{this->findNearest(d.first)};
-    if (nearest != end())
+    if(TAllocator::bulkRelease && std::is_trivially_destructible<std::pair<const TKey, TValue>>::value)
+    {
+        root.release(); // Nodes memory is owned by the arena, no destructor has to be run
+    }
+    while(root)
+    {
+        if(root->left) // Rotate right until the root has no left child
+        {
+            NodePtr left{std::move(root->left)};
+            root->left = std::move(left->right);
+            left->right = std::move(root);
+            root = std::move(left);
+        }
+        else // The root can be destroyed without recursion
+        {
+            root = std::move(root->right);
+        }
+    }
+    nodeArena.release();
+    rightmost = nullptr;
+    nodeCount = 0;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class... TArgs>
+std::pair<typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator, bool> BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::insertUnique(const TKey& key, TArgs&&... args)
+{
+    Node * nearest = findNearest(key).getNode();
+    if(!nearest) // Tree is empty
+    {
+        return {Iterator{attach(nullptr, true, std::forward<TArgs>(args)...)}, true};
+    }
+    if(BST_COUNT(comparisons, 1), compare(nearest->data.first, key))
+    {
+        return {Iterator{attach(nearest, true, std::forward<TArgs>(args)...)}, true};
+    }
+    else if(BST_COUNT(comparisons, 1), compare(key, nearest->data.first))
+    {
+        return {Iterator{attach(nearest, false, std::forward<TArgs>(args)...)}, true};
+    }
+    return {Iterator{nearest}, false}; // Node was already present, no action performed.
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class... TArgs>
+std::pair<typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator, bool> BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::emplace(TArgs&&... args)
+{
+    std::pair<TKey, TValue> d(std::forward<TArgs>(args)...);
+    return insertUnique(d.first, std::move(d));
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::insert(Iterator hint, std::pair<TKey, TValue> d)
+{
+    Node * next = hint.getNode();
+    if(!root)
+    {
+        return Iterator{attach(nullptr, true, std::move(d))};
+    }
+    if(!next) // Hint is end(), the element should become the new rightmost
+    {
+        if(BST_COUNT(comparisons, 1), compare(rightmost->data.first, d.first))
+        {
+            return Iterator{attach(rightmost, true, std::move(d))};
+        }
+    }
+    else if(BST_COUNT(comparisons, 1), compare(d.first, next->data.first)) // Element before the hint
+    {
+        if(!next->left)
+        {
+            Node * previous = next;
+            while(previous->parent && previous == previous->parent->left.get())
+            {
+                previous = previous->parent;
+            }
+            previous = previous->parent;
+            if(!previous || (BST_COUNT(comparisons, 1), compare(previous->data.first, d.first)))
+            {
+                return Iterator{attach(next, false, std::move(d))};
+            }
+        }
+    }
+    else if(BST_COUNT(comparisons, 1), compare(next->data.first, d.first)) // Element after the hint
+    {
+        if(next == rightmost)
+        {
+            return Iterator{attach(next, true, std::move(d))};
+        }
+        if(!next->right)
+        {
+            Iterator following{next};
+            ++following;
+            if(BST_COUNT(comparisons, 1), compare(d.first, (*following).first))
+            {
+                return Iterator{attach(next, true, std::move(d))};
+            }
+        }
+    }
+    else // Element already present
+    {
+        return hint;
+    }
+    return insertUnique(d.first, std::move(d)).first;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class TInputIterator>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::assign(TInputIterator first, TInputIterator last)
+{
+    clear();
+    std::size_t size = 0;
+    for(; first != last; ++first)
     {
-        Node * node = nearest.getNode();
-        if(compare((*nearest).first,d.first))
+        if(rightmost && !compare(rightmost->data.first, (*first).first))
         {
-            node->right.reset(new Node{d, node});
-            return true;
+            continue; // Not sorted or duplicated key
         }
-        else if (compare(d.first,(*nearest).first))
+        appendToVine(*first);
+        ++size;
+    }
+    linkTree(size);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::save(std::ostream& os) const
+{
+    SnapshotFormat::Header header;
+    header.keySize = SnapshotFormat::sizeOf<TKey>();
+    header.valueSize = SnapshotFormat::sizeOf<TValue>();
+    header.keyType = SnapshotFormat::typeTag<TKey>();
+    header.valueType = SnapshotFormat::typeTag<TValue>();
+    header.count = nodeCount;
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    std::uint64_t checksum = SnapshotFormat::checksumSeed;
+    std::uint64_t offset = sizeof(header) + saveSection<TKey>(os, checksum, [](const std::pair<const TKey, TValue>& pair) -> const TKey& { return pair.first; });
+    const char padding[SnapshotFormat::valueAlignment] = {};
+    std::size_t paddingSize = SnapshotFormat::padding(offset);
+    os.write(padding, paddingSize);
+    checksum = SnapshotFormat::checksum(checksum, padding, paddingSize);
+    saveSection<TValue>(os, checksum, [](const std::pair<const TKey, TValue>& pair) -> const TValue& { return pair.second; });
+    os.write(reinterpret_cast<const char *>(&checksum), sizeof(checksum));
+    if(!os)
+    {
+        throw std::runtime_error{"The snapshot could not be written."};
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::load(std::istream& is)
+{
+    SnapshotFormat::Header header;
+    SnapshotFormat::Header expected;
+    expected.keySize = SnapshotFormat::sizeOf<TKey>();
+    expected.valueSize = SnapshotFormat::sizeOf<TValue>();
+    expected.keyType = SnapshotFormat::typeTag<TKey>();
+    expected.valueType = SnapshotFormat::typeTag<TValue>();
+    if(!is.read(reinterpret_cast<char *>(&header), sizeof(header)) || !std::equal(header.magic, header.magic + sizeof(header.magic), expected.magic))
+    {
+        throw std::runtime_error{"The stream does not contain a snapshot."};
+    }
+    if(header.version != expected.version || header.byteOrder != expected.byteOrder)
+    {
+        throw std::runtime_error{"The snapshot has an unsupported version or byte order."};
+    }
+    if(header.keySize != expected.keySize || header.valueSize != expected.valueSize || header.keyType != expected.keyType || header.valueType != expected.valueType)
+    {
+        throw std::runtime_error{"The snapshot was written for other key or value types."};
+    }
+    std::uint64_t checksum = SnapshotFormat::checksumSeed;
+    std::uint64_t offset = sizeof(header);
+    std::vector<TKey> keys = loadSection<TKey>(is, checksum, header.count, offset);
+    char padding[SnapshotFormat::valueAlignment];
+    std::size_t paddingSize = SnapshotFormat::padding(offset);
+    if(!is.read(padding, paddingSize))
+    {
+        throw std::runtime_error{"The snapshot is truncated."};
+    }
+    checksum = SnapshotFormat::checksum(checksum, padding, paddingSize);
+    std::vector<TValue> values = loadSection<TValue>(is, checksum, header.count, offset);
+    std::uint64_t written;
+    if(!is.read(reinterpret_cast<char *>(&written), sizeof(written)) || written != checksum)
+    {
+        throw std::runtime_error{"The snapshot is corrupted."};
+    }
+    for(std::size_t i = 1; i < keys.size(); ++i)
+    {
+        if(!compare(keys[i - 1], keys[i]))
         {
-            node->left.reset(new Node{d, node});
-            return true;
+            throw std::runtime_error{"The keys of the snapshot are not sorted."};
         }
-        return false; // Node was already present, no action performed.
     }
-    else // Tree is empty
+    BinarySearchTree loaded; // Built aside, so that this tree is unchanged if a node can't be created
+    loaded.compare = compare;
+    loaded.autoBalanceFactor = autoBalanceFactor;
+    for(std::size_t i = 0; i < keys.size(); ++i)
     {
-        root.reset(new Node{d});
-        return true;
+        loaded.appendToVine(std::move(keys[i]), std::move(values[i]));
     }
+    loaded.linkTree(keys.size());
+    *this = std::move(loaded);
 }
 
-template <class TKey,class TValue,class TCompare>
-std::ostream& BinarySearchTree<TKey, TValue, TCompare>::printOrderedList(std::ostream& os) const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+std::ostream& BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::printOrderedList(std::ostream& os) const
 {
     ConstIterator it{cbegin()};
     ConstIterator end{cend()};
@@ -128,8 +1063,8 @@ std::ostream& BinarySearchTree<TKey, TValue, TCompare>::printOrderedList(std::os
     return os;
 }
 
-template <class TKey,class TValue,class TCompare>
-std::ostream& BinarySearchTree<TKey, TValue, TCompare>::printTree(std::ostream& os) const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+std::ostream& BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::printTree(std::ostream& os) const
 {
     if (!root)
     {
@@ -147,38 +1082,410 @@ std::ostream& BinarySearchTree<TKey, TValue, TCompare>::printTree(std::ostream&
     return os;
 }
 
-template <class TKey,class TValue,class TCompare>
-typename BinarySearchTree<TKey, TValue, TCompare>::Iterator BinarySearchTree<TKey, TValue, TCompare>::find(TKey key) const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class TKeyArg>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::findEquivalent(const TKeyArg& key) const
 {
+    BST_COUNT(finds, 1);
     Iterator nearest{this->findNearest(key)};
     if (nearest != end())
     {
-        return (*nearest).first == key ? nearest : end();
+        const TKey& nearestKey = (*nearest).first;
+        return compare(nearestKey, key) || compare(key, nearestKey) ? end() : nearest;
     }
     return end();
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::lower_bound(const TKey& key) const
+{
+    Iterator nearest{this->findNearest(key)};
+    if(nearest != end() && compare((*nearest).first, key))
+    {
+        ++nearest; // The key would be the right child of the nearest node
+    }
+    return nearest;
+}
 
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::upper_bound(const TKey& key) const
+{
+    Iterator nearest{this->findNearest(key)};
+    if(nearest != end() && !compare(key, (*nearest).first))
+    {
+        ++nearest; // The nearest key is equivalent or would be the parent of the key on the left
+    }
+    return nearest;
 }
 
-template <class TKey,class TValue,class TCompare>
-void BinarySearchTree<TKey, TValue, TCompare>::balance()
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+std::size_t BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::rank(const TKey& key) const
 {
-    Iterator it{this->begin()};
-    Iterator end{this->end()};
-    std::vector<std::pair<TKey, TValue>> nodes;
-    if(it == end)
+    requireOrderStatistics();
+    std::size_t position = 0;
+    Node * node = root.get();
+    while(node)
+    {
+        if(compare(node->data.first, key)) // The node and its left subtree are less than key
+        {
+            position += 1 + subtreeSize(node->left);
+            node = node->right.get();
+        }
+        else
+        {
+            node = node->left.get();
+        }
+    }
+    return position;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::select(std::size_t k) const
+{
+    requireOrderStatistics();
+    Node * node = root.get();
+    while(node)
+    {
+        std::size_t leftSize = subtreeSize(node->left);
+        if(k < leftSize)
+        {
+            node = node->left.get();
+        }
+        else if(k > leftSize)
+        {
+            k -= leftSize + 1;
+            node = node->right.get();
+        }
+        else
+        {
+            return Iterator{node};
+        }
+    }
+    return end();
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class TForwardIterator, class TOutputIterator>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::find_many(TForwardIterator first, TForwardIterator last, TOutputIterator out) const
+{
+    const TKey * keys[batchSize];
+    Node * nodes[batchSize]; // Current node of every traversal, nullptr when finished
+    Node * found[batchSize];
+    while(first != last)
+    {
+        std::size_t count = 0;
+        for(; first != last && count < batchSize; ++first, ++count)
+        {
+            keys[count] = &*first;
+            nodes[count] = root.get();
+            found[count] = nullptr;
+        }
+        BST_COUNT(finds, count);
+        bool active = true;
+        while(active)
+        {
+            active = false;
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                Node * node = nodes[i];
+                if(!node)
+                {
+                    continue;
+                }
+                BST_COUNT(visitedNodes, 1);
+                BST_COUNT(comparisons, 1);
+                if(compare(node->data.first, *keys[i]))
+                {
+                    node = node->right.get();
+                }
+                else if(BST_COUNT(comparisons, 1), compare(*keys[i], node->data.first))
+                {
+                    node = node->left.get();
+                }
+                else // Node was found
+                {
+                    found[i] = node;
+                    node = nullptr;
+                }
+                if(node)
+                {
+                    #if defined(__GNUC__)
+                    __builtin_prefetch(node);
+                    #endif
+                    active = true;
+                }
+                nodes[i] = node;
+            }
+        }
+        for(std::size_t i = 0; i < count; ++i, ++out)
+        {
+            *out = Iterator{found[i]};
+        }
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::balance()
+{
+    if(root)
+    {
+        vineToTree(treeToVine());
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::parallel_balance(std::size_t threads)
+{
+    if(!root)
     {
         return;
     }
-    for(; it != end; ++it)
+    threads = std::max<std::size_t>(threads, 1);
+    std::vector<std::pair<Node *, bool>> pieces;
+    partition(root.get(), partitionDepth(threads), pieces);
+    std::vector<std::size_t> offsets(pieces.size() + 1, 0);
+    parallelRun(pieces.size(), [&pieces, &offsets](std::size_t id)
+    {
+        std::size_t count = 0;
+        auto increment = [&count](Node *) { ++count; };
+        if(pieces[id].second)
+        {
+            visitSubtree(pieces[id].first, increment);
+        }
+        offsets[id + 1] = pieces[id].second ? count : 1;
+    }, threads);
+    for(std::size_t id = 0; id < pieces.size(); ++id)
     {
-        nodes.push_back(*it);
+        offsets[id + 1] += offsets[id];
     }
-    clear();
-    rebuildBalancedTree(nodes, 0, nodes.size() - 1);
+    std::vector<Node *> nodes(offsets.back());
+    parallelRun(pieces.size(), [&pieces, &offsets, &nodes](std::size_t id)
+    {
+        Node ** out = nodes.data() + offsets[id];
+        auto collect = [&out](Node * node) { *out++ = node; };
+        if(pieces[id].second)
+        {
+            visitSubtree(pieces[id].first, collect);
+        }
+        else
+        {
+            collect(pieces[id].first);
+        }
+    }, threads);
+    // Links are owned again by the relinked nodes, so their current ownership is dropped
+    std::size_t chunk = nodes.size() / pieces.size() + 1;
+    parallelRun(pieces.size(), [&nodes, chunk](std::size_t id)
+    {
+        for(std::size_t i = id * chunk; i < std::min(nodes.size(), (id + 1) * chunk); ++i)
+        {
+            nodes[i]->left.release();
+            nodes[i]->right.release();
+        }
+    }, threads);
+    root.release();
+    int height = 0;
+    for(std::size_t size = nodes.size(); size; size >>= 1)
+    {
+        ++height;
+    }
+    int forks = 0;
+    for(std::size_t t = threads; t > 1; t = (t + 1) / 2)
+    {
+        ++forks;
+    }
+    root.reset(parallelLink(nodes.data(), nodes.size(), nullptr, 0, height, forks));
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class TVisit>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::parallel_for_each(TVisit visit, std::size_t threads)
+{
+    std::vector<std::pair<Node *, bool>> pieces;
+    partition(root.get(), partitionDepth(std::max<std::size_t>(threads, 1)), pieces);
+    parallelRun(pieces.size(), [&pieces, &visit](std::size_t id)
+    {
+        auto visitNode = [&visit](Node * node) { visit(node->data); };
+        if(pieces[id].second)
+        {
+            visitSubtree(pieces[id].first, visitNode);
+        }
+        else
+        {
+            visitNode(pieces[id].first);
+        }
+    }, threads);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+template <class T, class TAccumulate, class TCombine>
+T BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::parallel_reduce(T identity, TAccumulate accumulate, TCombine combine, std::size_t threads) const
+{
+    std::vector<std::pair<Node *, bool>> pieces;
+    partition(root.get(), partitionDepth(std::max<std::size_t>(threads, 1)), pieces);
+    std::vector<T> results(pieces.size(), identity);
+    parallelRun(pieces.size(), [&pieces, &results, &accumulate](std::size_t id)
+    {
+        T& result = results[id];
+        auto accumulateNode = [&result, &accumulate](Node * node)
+        {
+            result = accumulate(std::move(result), static_cast<const std::pair<const TKey, TValue>&>(node->data));
+        };
+        if(pieces[id].second)
+        {
+            visitSubtree(pieces[id].first, accumulateNode);
+        }
+        else
+        {
+            accumulateNode(pieces[id].first);
+        }
+    }, threads);
+    T result{std::move(identity)};
+    for(T& partial : results)
+    {
+        result = combine(std::move(result), std::move(partial));
+    }
+    return result;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Statistics BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::stats() const
+{
+    Statistics statistics;
+    std::size_t totalDepth = 0;
+    Node * node = root.get();
+    int depth = 0;
+    while(node) // Pre-order visit through the parent pointers
+    {
+        if(statistics.depthHistogram.size() <= std::size_t(depth))
+        {
+            statistics.depthHistogram.push_back(0);
+        }
+        ++statistics.depthHistogram[depth];
+        ++statistics.size;
+        totalDepth += depth;
+        if(node->left || node->right)
+        {
+            node = node->left ? node->left.get() : node->right.get();
+            ++depth;
+            continue;
+        }
+        // Back to the first ancestor with a right subtree still to be visited
+        Node * parent = node->parent;
+        while(parent && (node == parent->right.get() || !parent->right))
+        {
+            node = parent;
+            parent = node->parent;
+            --depth;
+        }
+        node = parent ? parent->right.get() : nullptr;
+    }
+    statistics.height = int(statistics.depthHistogram.size());
+    statistics.maxDepth = statistics.height ? statistics.height - 1 : 0;
+    statistics.averageDepth = statistics.size ? double(totalDepth) / statistics.size : 0;
+    return statistics;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Counters BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::counters() const
+{
+    Counters values;
+    #ifdef BSTCOUNTERS
+    values.finds = operationCounters.finds;
+    values.inserts = operationCounters.inserts;
+    values.comparisons = operationCounters.comparisons;
+    values.visitedNodes = operationCounters.visitedNodes;
+    values.allocations = operationCounters.allocations;
+    values.autoBalances = operationCounters.autoBalances;
+    #endif
+    return values;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::reset_counters()
+{
+    #ifdef BSTCOUNTERS
+    operationCounters.finds = 0;
+    operationCounters.inserts = 0;
+    operationCounters.comparisons = 0;
+    operationCounters.visitedNodes = 0;
+    operationCounters.allocations = 0;
+    operationCounters.autoBalances = 0;
+    #endif
 }
 
-template <class TKey,class TValue,class TCompare>
-typename BinarySearchTree<TKey, TValue, TCompare>::Iterator BinarySearchTree<TKey, TValue, TCompare>::begin() const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::merge(BinarySearchTree&& other)
+{
+    if(this == &other)
+    {
+        return;
+    }
+    nodeArena.share(other.nodeArena);
+    std::size_t size = treeToVine() + other.treeToVine();
+    NodePtr left{std::move(root)};
+    NodePtr right{std::move(other.root)};
+    NodePtr * tail = &root;
+    while(left && right)
+    {
+        NodePtr& next = compare(left->data.first, right->data.first) ? left : right;
+        if(&next == &right && !compare(right->data.first, left->data.first)) // Key already present
+        {
+            NodePtr duplicate{std::move(right)};
+            right = std::move(duplicate->right);
+            --size;
+            continue;
+        }
+        *tail = std::move(next);
+        next = std::move((*tail)->right);
+        tail = &(*tail)->right;
+    }
+    *tail = left ? std::move(left) : std::move(right); // Remaining nodes are already in order
+    linkTree(size);
+    other.clear();
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation> BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::split(const TKey& key)
+{
+    BinarySearchTree greater;
+    greater.compare = compare;
+    greater.nodeArena.share(nodeArena);
+    std::size_t size = treeToVine();
+    std::size_t lessSize = 0;
+    NodePtr * link = &root;
+    while(*link && compare((*link)->data.first, key))
+    {
+        link = &(*link)->right;
+        ++lessSize;
+    }
+    greater.root = std::move(*link);
+    greater.linkTree(size - lessSize);
+    linkTree(lessSize);
+    return greater;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+void BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::join(BinarySearchTree&& other)
+{
+    if(this == &other || !other.root)
+    {
+        return;
+    }
+    if(root && !compare(rightmost->data.first, (*other.begin()).first))
+    {
+        throw std::invalid_argument{"The keys of the joined tree must be greater than the keys of the tree."};
+    }
+    nodeArena.share(other.nodeArena);
+    std::size_t size = treeToVine() + other.treeToVine();
+    Node * last = rightmost; // Still the last node of the vine
+    NodePtr& tail = last ? last->right : root;
+    tail = std::move(other.root);
+    linkTree(size);
+    other.clear();
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::begin() const
 {
     if(!root)
     {
@@ -192,8 +1499,8 @@ typename BinarySearchTree<TKey, TValue, TCompare>::Iterator BinarySearchTree<TKe
     return Iterator{node};
 }
 
-template <class TKey,class TValue,class TCompare>
-typename BinarySearchTree<TKey, TValue, TCompare>::ConstIterator BinarySearchTree<TKey, TValue, TCompare>::cbegin() const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+typename BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::ConstIterator BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::cbegin() const
 {
     if(!root)
     {
@@ -209,38 +1516,44 @@ typename BinarySearchTree<TKey, TValue, TCompare>::ConstIterator BinarySearchTre
 
 // Operators
 
-template <class TKey,class TValue,class TCompare>
-BinarySearchTree<TKey, TValue, TCompare>& BinarySearchTree<TKey, TValue, TCompare>::operator=(const BinarySearchTree& bst)
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>& BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::operator=(const BinarySearchTree& bst)
 {
-    clear();
-    copy(bst.root);
+    if(this != &bst)
+    {
+        clear();
+        compare = bst.compare;
+        autoBalanceFactor = bst.autoBalanceFactor;
+        copy(bst.root);
+    }
     return *this;
 }
 
-template <class TKey,class TValue,class TCompare>
-BinarySearchTree<TKey, TValue, TCompare>& BinarySearchTree<TKey, TValue, TCompare>::operator=(BinarySearchTree&& bst)
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>& BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::operator=(BinarySearchTree&& bst)
 {
-    root = std::move(bst.root);
+    if(this != &bst)
+    {
+        clear();
+        nodeArena = std::move(bst.nodeArena);
+        root = std::move(bst.root);
+        rightmost = bst.rightmost;
+        bst.rightmost = nullptr;
+        nodeCount = bst.nodeCount;
+        bst.nodeCount = 0;
+        autoBalanceFactor = bst.autoBalanceFactor;
+        compare = std::move(bst.compare);
+    }
     return *this;
 }
 
-template <class TKey,class TValue,class TCompare>
-TValue& BinarySearchTree<TKey, TValue, TCompare>::operator[](const TKey& key)
-{
-    std::pair<TKey, TValue> pair{key, TValue{}};
-    insert(pair); // Does nothing if node is already present
-    Iterator it{find(key)};
-    return (*it).second;
-}
-
-template <class TKey,class TValue,class TCompare>
-const TValue& BinarySearchTree<TKey, TValue, TCompare>::operator[](const TKey& key) const
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+const TValue& BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::operator[](const TKey& key) const
 {
-    std::pair<TKey, TValue> pair{key, TValue{}};
     ConstIterator it{find(key).getNode()};
     if (it == cend())
     {
-        throw; // The key is not present in the tree.
+        throw std::out_of_range{"The key is not present in the tree."};
     }
     return (*it).second;
 }
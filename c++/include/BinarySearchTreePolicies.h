@@ -0,0 +1,224 @@
+/**
+ * @file BinarySearchTreePolicies.h
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing the policy classes used to customize the BinarySearchTree class.
+ */
+
+#include <cstddef> // std::size_t
+#include <memory> // unique and shared pointers
+#include <new> // placement new
+#include <type_traits> // std::aligned_storage
+#include <utility> // std::forward
+#include <vector> // vector class
+
+#ifndef BINARYSEARCHTREEPOLICIES_H__
+#define BINARYSEARCHTREEPOLICIES_H__
+
+/**
+ * @brief Balancing policy which never rebalances the tree on insertion.
+ *
+ * Inserting keys in sorted order degenerates the tree into a list,
+ * and balance() has to be called manually to restore its performances.
+ */
+struct NoBalancing
+{
+	/** No additional data is stored inside the nodes. */
+	struct NodeData {};
+};
+
+/**
+ * @brief Balancing policy keeping the tree AVL-balanced on insertion.
+ *
+ * The heights of the two subtrees of every node differ at most by one,
+ * so the height of the tree is bounded by 1.44 * log2(n).
+ */
+struct AVLBalancing
+{
+	/** The height of the subtree rooted in the node. */
+	struct NodeData { int height = 1; };
+};
+
+/**
+ * @brief Balancing policy keeping the tree red-black balanced on insertion.
+ *
+ * Uses less rotations than AVL balancing on insertion, at the cost
+ * of a less strict bound on the height of the tree (2 * log2(n)).
+ */
+struct RedBlackBalancing
+{
+	/** The color of the node, new nodes are always red. */
+	struct NodeData { bool red = true; };
+};
+
+/**
+ * @brief Augmentation policy which stores no additional data in the nodes.
+ */
+struct NoAugmentation
+{
+	/** No additional data is stored inside the nodes. */
+	struct NodeData {};
+};
+
+/**
+ * @brief Augmentation policy storing the size of the subtree rooted in every node.
+ *
+ * Enables the order statistic methods rank, select and count_range in O(log n)
+ * on balanced trees, at the cost of updating the sizes on every insertion.
+ */
+struct OrderStatistics
+{
+	/** The number of nodes of the subtree rooted in the node. */
+	struct NodeData { std::size_t size = 1; };
+};
+
+/**
+ * @brief Allocation policy creating every node with its own heap allocation.
+ */
+struct HeapAllocation
+{
+	/** Nodes are owned one by one, so they can't be released all at once. */
+	static constexpr bool bulkRelease = false;
+	/** Deleter used by the unique pointers owning the nodes. */
+	template <class TNode>
+	using Deleter = std::default_delete<TNode>;
+	/**
+	 * @brief Stateless arena forwarding every node creation to operator new.
+	 * @tparam TNode Type of the nodes to be created.
+	 */
+	template <class TNode>
+	class Arena
+	{
+	public:
+		/**
+		 * @brief Creates a new node on the heap.
+		 * @param args The arguments forwarded to the node constructor.
+		 * @return TNode* The created node, to be owned by a unique pointer.
+		 */
+		template <class... TArgs>
+		TNode * create(TArgs&&... args) { return new TNode(std::forward<TArgs>(args)...); }
+		/**
+		 * @brief Shares the memory of another arena, nothing to do since nodes are owned one by one.
+		 * @param arena The arena whose nodes are moved into a tree using this arena.
+		 */
+		void share(const Arena& arena) { (void)arena; }
+		/**
+		 * @brief Releases the arena memory, nothing to do since nodes were deleted one by one.
+		 */
+		void release() {}
+	};
+};
+
+/**
+ * @brief Allocation policy creating nodes inside contiguous slab-allocated chunks.
+ * @tparam TChunkNodes Number of nodes contained in every chunk. Default 1024.
+ *
+ * Nodes are never freed one by one: the unique pointers owning them only run their
+ * destructors, while the memory is released all at once when the tree is cleared.
+ * Nodes created one after the other are contiguous, improving cache locality.
+ * Chunks are reference counted, so that nodes can be moved between trees by
+ * merging or splitting them: a chunk is released when no tree uses it anymore.
+ */
+template <std::size_t TChunkNodes = 1024>
+struct PoolAllocation
+{
+	static_assert(TChunkNodes > 0, "Chunks must contain at least one node");
+	/** The whole arena is released at once. */
+	static constexpr bool bulkRelease = true;
+	/**
+	 * @brief Deleter used by the unique pointers owning the nodes, only destroys them.
+	 */
+	template <class TNode>
+	struct Deleter
+	{
+		void operator()(TNode * node) const { node->~TNode(); }
+	};
+	/**
+	 * @brief Arena owning the chunks in which nodes are created.
+	 * @tparam TNode Type of the nodes to be created.
+	 */
+	template <class TNode>
+	class Arena
+	{
+	private:
+		/** Raw storage for a single node. */
+		using Slot = typename std::aligned_storage<sizeof(TNode), alignof(TNode)>::type;
+		/** Chunks allocated or shared so far, nodes are created in the last one. */
+		std::vector<std::shared_ptr<Slot[]>> chunks;
+		/** Number of slots already used in the last chunk. */
+		std::size_t used = TChunkNodes;
+	public:
+		/**
+		 * @brief Default constructor for an empty arena.
+		 */
+		Arena() {}
+		/**
+		 * @brief Move constructor for arena, the moved arena is left empty.
+		 * @param arena The arena whose chunks are moved into a new one.
+		 */
+		Arena(Arena&& arena) noexcept : chunks{std::move(arena.chunks)}, used{arena.used}
+		{
+			arena.chunks.clear();
+			arena.used = TChunkNodes;
+		}
+		/**
+		 * @brief Move assignment for arena, the current chunks are released.
+		 * @param arena The arena whose chunks are moved into an existing one.
+		 * @return Arena& The modified existing arena.
+		 */
+		Arena& operator=(Arena&& arena) noexcept
+		{
+			chunks = std::move(arena.chunks);
+			used = arena.used;
+			arena.chunks.clear();
+			arena.used = TChunkNodes;
+			return *this;
+		}
+		/**
+		 * @brief Creates a new node in the last chunk, allocating a new chunk if it is full.
+		 * @param args The arguments forwarded to the node constructor.
+		 * @return TNode* The created node, to be owned by a unique pointer.
+		 */
+		template <class... TArgs>
+		TNode * create(TArgs&&... args)
+		{
+			if(used == TChunkNodes)
+			{
+				chunks.emplace_back(new Slot[TChunkNodes]);
+				used = 0;
+			}
+			TNode * node = new (&chunks.back()[used]) TNode(std::forward<TArgs>(args)...);
+			++used;
+			return node;
+		}
+		/**
+		 * @brief Keeps the chunks of another arena alive, since some of their nodes are moved to this arena tree.
+		 * @param arena The arena whose chunks are shared.
+		 *
+		 * The last chunk stays the one in which nodes are created, so that a chunk
+		 * is never filled by two arenas at the same time.
+		 */
+		void share(const Arena& arena)
+		{
+			if(chunks.empty())
+			{
+				chunks = arena.chunks;
+				used = TChunkNodes;
+			}
+			else
+			{
+				chunks.insert(chunks.end() - 1, arena.chunks.begin(), arena.chunks.end());
+			}
+		}
+		/**
+		 * @brief Releases all the chunks at once, nodes must have been destroyed or be trivially destructible.
+		 */
+		void release()
+		{
+			chunks.clear();
+			used = TChunkNodes;
+		}
+	};
+};
+
+#endif //BINARYSEARCHTREEPOLICIES_H__
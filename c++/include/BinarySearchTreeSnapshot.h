@@ -0,0 +1,128 @@
+/**
+ * @file BinarySearchTreeSnapshot.h
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing the binary snapshot format shared by BinarySearchTree and MappedBinarySearchTree.
+ */
+
+#include <cstddef> // std::size_t
+#include <cstdint> // fixed width integers
+#include <string> // std::basic_string
+#include <type_traits> // std::is_trivially_copyable, std::is_integral, std::is_floating_point
+
+#ifndef BINARYSEARCHTREESNAPSHOT_H__
+#define BINARYSEARCHTREESNAPSHOT_H__
+
+/**
+ * @brief Checks whether a type is a string of trivially copyable characters, stored with its length in snapshots.
+ * @tparam T The type to be checked.
+ */
+template <class T>
+struct SnapshotString : std::false_type {};
+
+template <class TChar, class TTraits, class TAlloc>
+struct SnapshotString<std::basic_string<TChar, TTraits, TAlloc>> : std::is_trivially_copyable<TChar> {};
+
+/**
+ * @brief Binary snapshot format of a binary search tree.
+ *
+ * A snapshot contains a header, the keys in ascending order, padding up to
+ * a multiple of valueAlignment bytes, the values in the same order and a
+ * trailing checksum of everything between the header and the checksum.
+ * Trivially copyable keys and values are stored as contiguous arrays in
+ * native byte order, so that they can be used in place once the file is
+ * mapped in memory. Strings are stored as their length followed by their characters.
+ * The header identifies the key and value types by their tags, see typeTag.
+ */
+struct SnapshotFormat
+{
+	/** Version of the format, increased on every incompatible change. */
+	static constexpr std::uint32_t version = 2;
+	/** Value written in native byte order, used to detect snapshots from machines with a different one. */
+	static constexpr std::uint32_t byteOrderMark = 0x01020304;
+	/** Alignment of the values section, from the beginning of the snapshot. */
+	static constexpr std::uint64_t valueAlignment = 16;
+	/** Initial value of the checksum. */
+	static constexpr std::uint64_t checksumSeed = 14695981039346656037ULL;
+	/**
+	 * @brief Header at the beginning of every snapshot, whose size is a multiple of the value alignment.
+	 */
+	struct Header
+	{
+		/** Identifies the file as a snapshot. */
+		char magic[8] = {'B', 'S', 'T', 'S', 'N', 'A', 'P', '\0'};
+		/** Version of the format. */
+		std::uint32_t version = SnapshotFormat::version;
+		/** Size of every key, 0 if keys are strings. */
+		std::uint32_t keySize = 0;
+		/** Size of every value, 0 if values are strings. */
+		std::uint32_t valueSize = 0;
+		/** The byte order mark, as written by the machine creating the snapshot. */
+		std::uint32_t byteOrder = byteOrderMark;
+		/** Number of elements. */
+		std::uint64_t count = 0;
+		/** Tag of the key type. */
+		std::uint32_t keyType = 0;
+		/** Tag of the value type. */
+		std::uint32_t valueType = 0;
+		/** Reserved for future versions, always zero. */
+		char reserved[24] = {};
+	};
+	static_assert(sizeof(Header) == 64, "The snapshot header must have a fixed size");
+	/**
+	 * @brief Returns the size with which a type is stored in the header.
+	 * @tparam T The type of the keys or values.
+	 * @return std::uint32_t The size of the type if it is trivially copyable, 0 for strings.
+	 */
+	template <class T>
+	static constexpr std::uint32_t sizeOf()
+	{
+		static_assert(std::is_trivially_copyable<T>::value || SnapshotString<T>::value, "Snapshots only support trivially copyable types and strings");
+		return std::is_trivially_copyable<T>::value ? sizeof(T) : 0;
+	}
+	/** Kinds of types told apart by the type tags. */
+	enum TypeKind : std::uint32_t { otherKind = 1, signedKind, unsignedKind, floatingKind, stringKind };
+	/**
+	 * @brief Returns the tag with which a type is identified in the header.
+	 * @tparam T The type of the keys or values.
+	 * @return std::uint32_t The kind of the type in the lowest byte, followed by its size or by the size of the characters of strings.
+	 *
+	 * Integral types of different signedness and floating point types are told apart
+	 * even if their size is the same, other trivially copyable types only by their size.
+	 */
+	template <class T>
+	static constexpr std::uint32_t typeTag()
+	{
+		if constexpr(SnapshotString<T>::value)
+		{
+			return stringKind | std::uint32_t(sizeof(typename T::value_type)) << 8;
+		}
+		else
+		{
+			std::uint32_t kind = std::is_floating_point<T>::value ? floatingKind : !std::is_integral<T>::value ? otherKind : std::is_signed<T>::value ? signedKind : unsignedKind;
+			return kind | std::uint32_t(sizeof(T)) << 8;
+		}
+	}
+	/**
+	 * @brief Returns the number of padding bytes needed to align the values section.
+	 * @param offset The offset of the end of the keys section.
+	 */
+	static std::uint64_t padding(std::uint64_t offset) { return (valueAlignment - offset % valueAlignment) % valueAlignment; }
+	/**
+	 * @brief Updates the checksum, a 64 bit FNV-1a hash, with a block of bytes.
+	 * @param checksum The checksum of the previous bytes.
+	 * @param bytes The first byte of the block.
+	 * @param size The number of bytes of the block.
+	 * @return std::uint64_t The checksum including the block.
+	 */
+	static std::uint64_t checksum(std::uint64_t checksum, const char * bytes, std::size_t size)
+	{
+		for(std::size_t i = 0; i < size; ++i)
+		{
+			checksum = (checksum ^ static_cast<unsigned char>(bytes[i])) * 1099511628211ULL;
+		}
+		return checksum;
+	}
+};
+
+#endif //BINARYSEARCHTREESNAPSHOT_H__
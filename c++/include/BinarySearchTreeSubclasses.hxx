@@ -9,18 +9,21 @@
 
 /**
  * @brief A node of the binary search tree with two children nodes and one parent node.
+ * 
+ * The node inherits the data required by the balancing policy (e.g. height or color)
+ * and by the augmentation policy (e.g. subtree size).
  */
-template <class TKey,class TValue,class TCompare>
-struct BinarySearchTree<TKey, TValue, TCompare>::Node
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+struct BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Node : public TBalance::NodeData, public TAugmentation::NodeData
 {
 	/** Node's data in key-value format. 
 	 * Const was added to the key to ensure tree consistency.
 	*/
 	std::pair<const TKey, TValue> data;
 	/** Node's left child node (smaller key). */
-	std::unique_ptr<Node> left;
+	NodePtr left;
 	/** Node's right child node (bigger key). */
-	std::unique_ptr<Node> right;
+	NodePtr right;
 	/** Node's parent node. */
 	Node * parent;
 	/**
@@ -29,33 +32,29 @@ struct BinarySearchTree<TKey, TValue, TCompare>::Node
 	 */
 	Node() {}
 	/**
-	 * @brief Construct a new Node object without parent.
-	 * @param d The data to be inserted into the node.
-	 */
-	Node(std::pair<TKey, TValue> d): data{d}, left{nullptr}, right{nullptr}, parent{nullptr} {}
-	/**
-	 * @brief Construct a new Node object with a parent.
-	 * @param d The data to be inserted into the node.
-	 * @param p The parent of the node to be constructed.
+	 * @brief Construct a new Node object with a parent, building its data in place.
+	 * @param p The parent of the node to be constructed, nullptr for the root.
+	 * @param args The arguments forwarded to the constructor of the node's data.
 	 */
-	Node(std::pair<TKey, TValue> d, Node* p) : data{d}, left{nullptr}, right{nullptr}, parent{p} {}
+	template <class... TArgs>
+	Node(Node* p, TArgs&&... args) : data(std::forward<TArgs>(args)...), left{nullptr}, right{nullptr}, parent{p} {}
 	/**
 	 * @brief Copy constructor for Node class.
 	 * @param n The node to be copied.
 	 */
-	Node(const Node& n) : data{n.data}, left{nullptr}, right{nullptr}, parent{n.parent} {}
+	Node(const Node& n) : TBalance::NodeData(n), TAugmentation::NodeData(n), data{n.data}, left{nullptr}, right{nullptr}, parent{n.parent} {}
 };
 
 /**
  * @brief An iterator for the binary search tree class.
  */
-template <class TKey,class TValue,class TCompare>
-class BinarySearchTree<TKey, TValue, TCompare>::Iterator
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+class BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator
 {
 	/** Used to give access to getNode method */
 	friend class BinarySearchTree;
 	/** Alias to make names shorter and intuitive*/
-	using Node = BinarySearchTree<TKey, TValue, TCompare>::Node;
+	using Node = BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Node;
 private:
 	/** The node to which the iterator is currently referring. */
 	Node * currentNode;
@@ -134,14 +133,14 @@ public:
  * The only difference with a normal iterator from which it inherits is the 
  * constant pair returned by the deferencing operator.
  */
-template <class TKey,class TValue,class TCompare>
-class BinarySearchTree<TKey,TValue, TCompare>::ConstIterator : 
-public BinarySearchTree<TKey,TValue, TCompare>::Iterator
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator,class TAugmentation>
+class BinarySearchTree<TKey,TValue, TCompare, TBalance, TAllocator, TAugmentation>::ConstIterator : 
+public BinarySearchTree<TKey,TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator
 {
 	/** Used to give access to getNode method */
 	friend class BinarySearchTree;
 	/** Alias to make names shorter and intuitive*/
-	using Iterator = BinarySearchTree<TKey, TValue, TCompare>::Iterator;
+	using Iterator = BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator, TAugmentation>::Iterator;
 private:
 	/**
 	 * @brief Returns a constant pointer to the node pointed to by the iterator.
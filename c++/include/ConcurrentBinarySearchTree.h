@@ -0,0 +1,161 @@
+/**
+ * @file ConcurrentBinarySearchTree.h
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing variables and method names for the ConcurrentBinarySearchTree class.
+ */
+
+#include <algorithm> // std::upper_bound
+#include <iostream> // << operator
+#include <memory> // unique pointers
+#include <mutex> // std::unique_lock
+#include <optional> // std::optional
+#include <shared_mutex> // std::shared_mutex, std::shared_lock
+#include <utility> // std::pair
+#include <vector> // vector class
+#include "BinarySearchTree.h" // trees contained in the shards
+
+#ifndef CONCURRENTBINARYSEARCHTREE_H__
+#define CONCURRENTBINARYSEARCHTREE_H__
+
+/**
+ * @brief Thread-safe binary search tree split in key-range shards.
+ * @tparam TKey Type of node keys, used for ordering.
+ * @tparam TValue Type of node values.
+ * @tparam TCompare Type of the custom comparison iterator between nodes. Default std::less<TKey>.
+ * @tparam TBalance Balancing policy of the shards. Default RedBlackBalancing.
+ * @tparam TAllocator Allocation policy of the shards. Default HeapAllocation.
+ *
+ * The key space is split by a sorted list of boundary keys: shard i contains the keys
+ * not less than boundary i-1 and less than boundary i. Every shard is a BinarySearchTree
+ * guarded by its own reader-writer lock, so any number of threads can look up keys in
+ * parallel, and writers only block the readers of the shard they are modifying.
+ *
+ * Consistency model: every method is linearizable on a single key. Since references to
+ * the elements could be invalidated by concurrent writers, lookups return copies of the
+ * values and no iterator is exposed. Ordered traversals are performed by for_each, which
+ * visits the shards one after the other holding a shared lock on the visited shard only:
+ * the elements of every shard are a consistent snapshot of that shard, but writes to shards
+ * not yet visited or already visited during the traversal may or may not be observed.
+ */
+template <class TKey,class TValue,class TCompare = std::less<TKey>,class TBalance = RedBlackBalancing,class TAllocator = HeapAllocation>
+class ConcurrentBinarySearchTree
+{
+public:
+	/** Type of the trees contained in the shards. */
+	using Tree = BinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>;
+
+private:
+	/**
+	 * @brief A shard of the tree, aligned to a cache line to avoid false sharing between locks.
+	 */
+	struct alignas(64) Shard
+	{
+		/** Lock guarding the tree, shared by readers and exclusive for writers. */
+		mutable std::shared_mutex mutex;
+		/** Tree containing the keys of the shard range. */
+		Tree tree;
+	};
+	/** Sorted keys splitting the key space between the shards. */
+	std::vector<TKey> boundaries;
+	/** Shards in ascending key range order, one more than the boundaries. */
+	std::vector<std::unique_ptr<Shard>> shards;
+	/**
+	 * @brief Finds the shard whose range contains a key.
+	 * @param key The key to be located.
+	 * @return Shard& The shard containing the key.
+	 */
+	Shard& shardOf(const TKey& key) const;
+
+public:
+	/**
+	 * @brief Constructor for an empty concurrent binary search tree.
+	 * @param b The sorted boundary keys of the shards, the tree has one shard more than boundaries.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 *
+	 * Boundaries should be chosen so that the keys are spread evenly between the shards,
+	 * for example by sampling the expected keys. Without boundaries the tree has a single shard.
+	 */
+	ConcurrentBinarySearchTree(std::vector<TKey> b = {}, TCompare c = TCompare{});
+	/**
+	 * @brief Returns the number of shards of the tree.
+	 */
+	std::size_t shardCount() const { return shards.size(); }
+	/**
+	 * @brief Inserts a new element in the tree, if its key is not already present.
+	 * @param pair The key,value pair of the element to be inserted.
+	 * @return bool True if the element was inserted, false if the key was already present.
+	 */
+	bool insert(const std::pair<TKey, TValue>& pair);
+	/**
+	 * @brief Inserts a new element in the tree, or assigns a value to an existing key.
+	 * @param key The key of the element.
+	 * @param value The value to be assigned.
+	 * @return bool True if the element was inserted, false if an existing value was assigned.
+	 */
+	bool insert_or_assign(const TKey& key, const TValue& value);
+	/**
+	 * @brief Updates the value of an element in place while holding the shard exclusively.
+	 * @param key The key of the element to be updated.
+	 * @param update Function called on a reference to the value.
+	 * @return bool True if the element was found and updated, else false.
+	 */
+	template <class TUpdate>
+	bool update(const TKey& key, TUpdate update);
+	/**
+	 * @brief Used to find an element inside the tree.
+	 * @param key The key of the element to be found.
+	 * @return std::optional<TValue> A copy of the value of the element if it's found, else empty.
+	 */
+	std::optional<TValue> find(const TKey& key) const;
+	/**
+	 * @brief Checks whether an element is present inside the tree.
+	 * @param key The key of the element to be found.
+	 * @return bool True if the element is found, else false.
+	 */
+	bool contains(const TKey& key) const;
+	/**
+	 * @brief Visits the elements in ascending key order, see the consistency model of the class.
+	 * @param visit Function called on every constant key,value pair.
+	 *
+	 * The function must not access the tree, since the visited shard is locked.
+	 */
+	template <class TVisit>
+	void for_each(TVisit visit) const;
+	/**
+	 * @brief Balances the shards one after the other, blocking the readers of the balanced shard only.
+	 */
+	void balance();
+	/**
+	 * @brief Clears the content of the tree, one shard after the other.
+	 */
+	void clear();
+	/**
+	 * @brief Custom comparison operator for the concurrent binary search tree.
+	 */
+	TCompare compare;
+	/**
+	 * @brief Operator << to print the concurrent binary search tree in ascending key order.
+	 * @param os The output stream to which the strings to be printed are appended.
+	 * @param cbst The concurrent binary search tree instance to be printed.
+	 * @return std::ostream& The output stream to which strings have been appended.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, ConcurrentBinarySearchTree const& cbst)
+	{
+		bool empty = true;
+		cbst.for_each([&os, &empty](const std::pair<const TKey, TValue>& pair)
+		{
+			os << pair.first << ": " << pair.second << std::endl;
+			empty = false;
+		});
+		if(empty)
+		{
+			os << "Empty" << std::endl;
+		}
+		return os;
+	}
+};
+
+#include "ConcurrentBinarySearchTreeMethods.hxx"
+
+#endif //CONCURRENTBINARYSEARCHTREE_H__
@@ -0,0 +1,122 @@
+/**
+ * @file ConcurrentBinarySearchTreeMethods.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing method definitions for the ConcurrentBinarySearchTree class.
+ */
+
+#include "ConcurrentBinarySearchTree.h"
+
+// Private Methods
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+typename ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::Shard& ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::shardOf(const TKey& key) const
+{
+    // Boundaries are immutable after construction, so they can be read without locking
+    std::size_t id = std::upper_bound(boundaries.begin(), boundaries.end(), key, compare) - boundaries.begin();
+    return *shards[id];
+}
+
+// Public methods
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::ConcurrentBinarySearchTree(std::vector<TKey> b, TCompare c) : boundaries{std::move(b)}, compare{c}
+{
+    std::sort(boundaries.begin(), boundaries.end(), compare);
+    for(std::size_t i = 0; i <= boundaries.size(); ++i)
+    {
+        shards.emplace_back(new Shard{});
+        shards.back()->tree.compare = compare;
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+bool ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::insert(const std::pair<TKey, TValue>& pair)
+{
+    Shard& shard = shardOf(pair.first);
+    std::unique_lock<std::shared_mutex> lock{shard.mutex};
+    return shard.tree.insert(pair);
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+bool ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::insert_or_assign(const TKey& key, const TValue& value)
+{
+    Shard& shard = shardOf(key);
+    std::unique_lock<std::shared_mutex> lock{shard.mutex};
+    auto result = shard.tree.try_emplace(key, value);
+    if(!result.second)
+    {
+        (*result.first).second = value;
+    }
+    return result.second;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+template <class TUpdate>
+bool ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::update(const TKey& key, TUpdate update)
+{
+    Shard& shard = shardOf(key);
+    std::unique_lock<std::shared_mutex> lock{shard.mutex};
+    typename Tree::Iterator it{shard.tree.find(key)};
+    if(it == shard.tree.end())
+    {
+        return false;
+    }
+    update((*it).second);
+    return true;
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+std::optional<TValue> ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::find(const TKey& key) const
+{
+    const Shard& shard = shardOf(key);
+    std::shared_lock<std::shared_mutex> lock{shard.mutex};
+    typename Tree::Iterator it{shard.tree.find(key)};
+    if(it == shard.tree.end())
+    {
+        return std::nullopt;
+    }
+    return (*it).second; // Copied before releasing the lock
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+bool ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::contains(const TKey& key) const
+{
+    const Shard& shard = shardOf(key);
+    std::shared_lock<std::shared_mutex> lock{shard.mutex};
+    return shard.tree.find(key) != shard.tree.end();
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+template <class TVisit>
+void ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::for_each(TVisit visit) const
+{
+    for(const std::unique_ptr<Shard>& shard : shards)
+    {
+        std::shared_lock<std::shared_mutex> lock{shard->mutex};
+        for(typename Tree::ConstIterator it{shard->tree.cbegin()}; it != shard->tree.cend(); ++it)
+        {
+            visit(*it);
+        }
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+void ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::balance()
+{
+    for(std::unique_ptr<Shard>& shard : shards)
+    {
+        std::unique_lock<std::shared_mutex> lock{shard->mutex};
+        shard->tree.balance();
+    }
+}
+
+template <class TKey,class TValue,class TCompare,class TBalance,class TAllocator>
+void ConcurrentBinarySearchTree<TKey, TValue, TCompare, TBalance, TAllocator>::clear()
+{
+    for(std::unique_ptr<Shard>& shard : shards)
+    {
+        std::unique_lock<std::shared_mutex> lock{shard->mutex};
+        shard->tree.clear();
+    }
+}
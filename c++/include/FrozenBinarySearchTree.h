@@ -0,0 +1,182 @@
+/**
+ * @file FrozenBinarySearchTree.h
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing variables and method names for the FrozenBinarySearchTree class.
+ */
+
+#include <algorithm> // std::min
+#include <iostream> // << operator
+#include <stdexcept> // std::out_of_range
+#include <utility> // std::swap
+#include <vector> // vector class
+
+#ifndef FROZENBINARYSEARCHTREE_H__
+#define FROZENBINARYSEARCHTREE_H__
+
+/**
+ * @brief Immutable, read-optimized snapshot of a binary search tree.
+ * @tparam TKey Type of node keys, used for ordering.
+ * @tparam TValue Type of node values.
+ * @tparam TCompare Type of the custom comparison iterator between nodes. Default std::less<TKey>.
+ *
+ * Keys and values are stored in two separate contiguous arrays following the
+ * Eytzinger (breadth-first) layout of a complete binary search tree: the children
+ * of the element in position i are in positions 2i and 2i+1. The top levels of the
+ * tree share the same cache lines, the descendants of an element are prefetched
+ * a few levels in advance and the search loop contains no unpredictable branch.
+ * Keys and values must be default constructible.
+ */
+template <class TKey,class TValue,class TCompare = std::less<TKey>>
+class FrozenBinarySearchTree
+{
+public:
+	/**
+	 * @brief A constant iterator for the frozen binary search tree class.
+	 */
+	class ConstIterator;
+	/** Frozen trees can't be modified, so their iterators are always constant. */
+	using Iterator = ConstIterator;
+
+private:
+	/** Keys in Eytzinger order, starting from position 1. */
+	std::vector<TKey> keys;
+	/** Values in Eytzinger order, starting from position 1. */
+	std::vector<TValue> values;
+	/**
+	 * @brief Number of keys after which the descendants of an element are prefetched.
+	 *
+	 * The descendants of element i at a given level are contiguous, so prefetching
+	 * the element in position i * prefetchStride loads a whole cache line of them.
+	 */
+	static constexpr std::size_t prefetchStride = sizeof(TKey) >= 64 ? 1 : 64 / sizeof(TKey);
+	/**
+	 * @brief Recursively places the sorted elements in Eytzinger order.
+	 * @param sortedKeys The keys in ascending order.
+	 * @param sortedValues The values in ascending key order.
+	 * @param next The id of the next sorted element to be placed, for recursion purposes.
+	 * @param position The Eytzinger position to be filled, for recursion purposes.
+	 * @return std::size_t The id of the next sorted element to be placed.
+	 */
+	std::size_t fill(std::vector<TKey>& sortedKeys, std::vector<TValue>& sortedValues, std::size_t next, std::size_t position);
+	/**
+	 * @brief Finds the position of the first element whose key is not less than a key.
+	 * @param key The key to be searched.
+	 * @return std::size_t The Eytzinger position of the element, 0 if all keys are less than key.
+	 */
+	std::size_t lowerBoundPosition(const TKey& key) const;
+
+public:
+	/**
+	 * @brief Default constructor for an empty frozen binary search tree.
+	 */
+	FrozenBinarySearchTree() : keys(1), values(1) {}
+	/**
+	 * @brief Constructor for frozen binary search tree from a range sorted by key.
+	 * @param first The iterator to the first key,value pair of the range.
+	 * @param last The iterator past the last key,value pair of the range.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 *
+	 * Elements whose key is not greater than the key of the previous element are skipped.
+	 */
+	template <class TInputIterator>
+	FrozenBinarySearchTree(TInputIterator first, TInputIterator last, TCompare c = TCompare{});
+	/**
+	 * @brief Copy constructor for frozen binary search tree.
+	 */
+	FrozenBinarySearchTree(const FrozenBinarySearchTree&) = default;
+	/**
+	 * @brief Move constructor for frozen binary search tree, leaving the moved tree empty.
+	 * @param fbst The frozen binary search tree to be moved.
+	 *
+	 * The moved tree gets the sentinel slot of a new empty tree, which size() and find() rely on.
+	 */
+	FrozenBinarySearchTree(FrozenBinarySearchTree&& fbst) : FrozenBinarySearchTree() { swap(fbst); }
+	/**
+	 * @brief Copy assignment for frozen binary search tree.
+	 * @return FrozenBinarySearchTree& The modified existing tree.
+	 */
+	FrozenBinarySearchTree& operator=(const FrozenBinarySearchTree&) = default;
+	/**
+	 * @brief Move assignment for frozen binary search tree, leaving the moved tree empty.
+	 * @param fbst The frozen binary search tree to be moved into an existing one.
+	 * @return FrozenBinarySearchTree& The modified existing tree.
+	 */
+	FrozenBinarySearchTree& operator=(FrozenBinarySearchTree&& fbst)
+	{
+		FrozenBinarySearchTree moved{std::move(fbst)};
+		swap(moved);
+		return *this;
+	}
+	/**
+	 * @brief Exchanges the elements and the comparison functions of two frozen binary search trees.
+	 * @param fbst The frozen binary search tree to be exchanged with this one.
+	 */
+	void swap(FrozenBinarySearchTree& fbst)
+	{
+		keys.swap(fbst.keys);
+		values.swap(fbst.values);
+		std::swap(compare, fbst.compare);
+	}
+	/**
+	 * @brief Returns the number of elements of the tree.
+	 */
+	std::size_t size() const { return keys.size() - 1; }
+	/**
+	 * @brief Used to find an element inside the tree.
+	 * @param key The key of the element to be found.
+	 * @return ConstIterator An iterator to the element if it's found, else to end().
+	 */
+	ConstIterator find(const TKey& key) const;
+	/**
+	 * @brief Prints elements in ascending key order.
+	 * @param os The stream to which elements are sent.
+	 */
+	std::ostream& printOrderedList(std::ostream& os) const;
+	/**
+	 * @brief Used to begin an iteration on the frozen binary search tree.
+	 * @return ConstIterator An iterator to the element with the lowest key.
+	 */
+	ConstIterator begin() const;
+	/**
+	 * @brief Used to finish an iteration on the frozen binary search tree.
+	 * @return ConstIterator An iterator past the element with the highest key.
+	 */
+	ConstIterator end() const { return ConstIterator{this, 0}; }
+	/**
+	 * @brief Used to begin an iteration on the frozen binary search tree.
+	 * @return ConstIterator An iterator to the element with the lowest key.
+	 */
+	ConstIterator cbegin() const { return begin(); }
+	/**
+	 * @brief Used to finish an iteration on the frozen binary search tree.
+	 * @return ConstIterator An iterator past the element with the highest key.
+	 */
+	ConstIterator cend() const { return end(); }
+	/**
+	 * @brief Custom comparison operator for the frozen binary search tree.
+	 */
+	TCompare compare;
+	/**
+	 * @brief Operator [] to access an element value in the tree.
+	 * @param key The key of the element which value should be accessed.
+	 * @return const TValue& The value of the accessed element.
+	 * @throw std::out_of_range If the key is not present in the tree.
+	 */
+	const TValue& operator[](const TKey& key) const;
+	/**
+	 * @brief Operator << to print the frozen binary search tree in ascending key order.
+	 * @param os The output stream to which the strings to be printed are appended.
+	 * @param fbst The frozen binary search tree instance to be printed.
+	 * @return std::ostream& The output stream to which strings have been appended.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, FrozenBinarySearchTree const& fbst)
+	{
+		return fbst.printOrderedList(os);
+	}
+};
+
+#include "FrozenBinarySearchTreeSubclasses.hxx"
+#include "FrozenBinarySearchTreeMethods.hxx"
+
+#endif //FROZENBINARYSEARCHTREE_H__
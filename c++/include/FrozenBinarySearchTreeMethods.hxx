@@ -0,0 +1,118 @@
+/**
+ * @file FrozenBinarySearchTreeMethods.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing method definitions for the FrozenBinarySearchTree class.
+ */
+
+#include "FrozenBinarySearchTree.h"
+
+// Private Methods
+
+template <class TKey,class TValue,class TCompare>
+std::size_t FrozenBinarySearchTree<TKey, TValue, TCompare>::fill(std::vector<TKey>& sortedKeys, std::vector<TValue>& sortedValues, std::size_t next, std::size_t position)
+{
+    if(position < keys.size())
+    {
+        next = fill(sortedKeys, sortedValues, next, 2 * position);
+        keys[position] = std::move(sortedKeys[next]);
+        values[position] = std::move(sortedValues[next]);
+        next = fill(sortedKeys, sortedValues, next + 1, 2 * position + 1);
+    }
+    return next;
+}
+
+template <class TKey,class TValue,class TCompare>
+std::size_t FrozenBinarySearchTree<TKey, TValue, TCompare>::lowerBoundPosition(const TKey& key) const
+{
+    const TKey * data = keys.data();
+    std::size_t size = keys.size() - 1;
+    std::size_t position = 1;
+    while(position <= size)
+    {
+        #if defined(__GNUC__)
+        __builtin_prefetch(data + std::min(position * prefetchStride, size));
+        #endif
+        position = 2 * position + compare(data[position], key); // Branchless descent
+    }
+    // The path went right on every trailing 1 bit: the lower bound is the
+    // last element on which it went left, 0 if it always went right.
+    while(position & 1)
+    {
+        position >>= 1;
+    }
+    return position >> 1;
+}
+
+// Public methods
+
+template <class TKey,class TValue,class TCompare>
+template <class TInputIterator>
+FrozenBinarySearchTree<TKey, TValue, TCompare>::FrozenBinarySearchTree(TInputIterator first, TInputIterator last, TCompare c) : compare{c}
+{
+    std::vector<TKey> sortedKeys;
+    std::vector<TValue> sortedValues;
+    for(; first != last; ++first)
+    {
+        if(!sortedKeys.empty() && !compare(sortedKeys.back(), (*first).first))
+        {
+            continue; // Not sorted or duplicated key
+        }
+        sortedKeys.push_back((*first).first);
+        sortedValues.push_back((*first).second);
+    }
+    keys.resize(sortedKeys.size() + 1);
+    values.resize(sortedValues.size() + 1);
+    fill(sortedKeys, sortedValues, 0, 1);
+}
+
+template <class TKey,class TValue,class TCompare>
+typename FrozenBinarySearchTree<TKey, TValue, TCompare>::ConstIterator FrozenBinarySearchTree<TKey, TValue, TCompare>::find(const TKey& key) const
+{
+    std::size_t position = lowerBoundPosition(key);
+    if(position && !compare(key, keys[position]))
+    {
+        return ConstIterator{this, position};
+    }
+    return end();
+}
+
+template <class TKey,class TValue,class TCompare>
+std::ostream& FrozenBinarySearchTree<TKey, TValue, TCompare>::printOrderedList(std::ostream& os) const
+{
+    ConstIterator it{cbegin()};
+    ConstIterator end{cend()};
+    if(it == end)
+    {
+        os << "Empty" << std::endl;
+    }
+    for(; it != end; ++it)
+    {
+        os << (*it).first << ": " << (*it).second << std::endl;
+    }
+    return os;
+}
+
+template <class TKey,class TValue,class TCompare>
+typename FrozenBinarySearchTree<TKey, TValue, TCompare>::ConstIterator FrozenBinarySearchTree<TKey, TValue, TCompare>::begin() const
+{
+    std::size_t position = size() ? 1 : 0;
+    while(position && 2 * position <= size())
+    {
+        position *= 2;
+    }
+    return ConstIterator{this, position};
+}
+
+// Operators
+
+template <class TKey,class TValue,class TCompare>
+const TValue& FrozenBinarySearchTree<TKey, TValue, TCompare>::operator[](const TKey& key) const
+{
+    ConstIterator it{find(key)};
+    if (it == cend())
+    {
+        throw std::out_of_range{"The key is not present in the tree."};
+    }
+    return (*it).second;
+}
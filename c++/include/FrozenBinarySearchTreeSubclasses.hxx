@@ -0,0 +1,91 @@
+/**
+ * @file FrozenBinarySearchTreeSubclasses.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing the ConstIterator nested class of FrozenBinarySearchTree.
+ */
+
+#include "FrozenBinarySearchTree.h"
+
+/**
+ * @brief A constant iterator for the frozen binary search tree class.
+ *
+ * Keys and values are stored in separate arrays, so the dereferencing operator
+ * returns a pair of constant references instead of a reference to a pair.
+ * The iterator visits the Eytzinger positions in ascending key order.
+ */
+template <class TKey,class TValue,class TCompare>
+class FrozenBinarySearchTree<TKey, TValue, TCompare>::ConstIterator
+{
+private:
+	/** The tree on which the iteration is performed. */
+	const FrozenBinarySearchTree * tree;
+	/** The Eytzinger position of the current element, 0 for end(). */
+	std::size_t position;
+public:
+	/**
+	 * @brief Construct an iterator on an element of the tree.
+	 * @param t The tree on which the iterator is constructed.
+	 * @param p The Eytzinger position of the element.
+	 */
+	ConstIterator(const FrozenBinarySearchTree * t, std::size_t p) : tree{t}, position{p} {}
+	/**
+	 * @brief Operator it() for deferencing a frozen binary search tree iterator.
+	 * @return std::pair<const TKey&, const TValue&> Constant references to current element's key and value.
+	 */
+	std::pair<const TKey&, const TValue&> operator*() const
+	{
+		return std::pair<const TKey&, const TValue&>{tree->keys[position], tree->values[position]};
+	}
+	/**
+	 * @brief Operator ++it to advance iterator to the next element.
+	 * @return ConstIterator& Reference to an iterator pointing on the next element.
+	 */
+	ConstIterator& operator++()
+	{
+		std::size_t size = tree->size();
+		if(!position)
+		{
+			return *this;
+		}
+		else if(2 * position + 1 <= size) // Leftmost element of the right subtree
+		{
+			position = 2 * position + 1;
+			while(2 * position <= size)
+			{
+				position *= 2;
+			}
+		}
+		else // First ancestor of which the element is in the left subtree
+		{
+			while(position & 1)
+			{
+				position >>= 1;
+			}
+			position >>= 1;
+		}
+		return *this;
+	}
+	/**
+	 * @brief Operator it++ to advance iterator to the next element.
+	 * @return ConstIterator Value of the current iterator before advancing it to the next element.
+	 */
+	ConstIterator operator++(int)
+	{
+		ConstIterator it{*this};
+		++(*this);
+		return it;
+	}
+	/**
+	 * @brief Operator == to check for iterators equality.
+	 * @param other The iterator to be compared with this one.
+	 * @return True if iterators point to the same element, else false
+	 */
+	bool operator==(const ConstIterator& other) const { return position == other.position; }
+	/**
+	 * @brief Operator != to check for iterators inequality.
+	 * @param other The iterator to be compared with this one.
+	 * @return False if iterators point to the same element, else true.
+	 */
+	bool operator!=(const ConstIterator& other) const { return position != other.position; }
+};
@@ -0,0 +1,171 @@
+/**
+ * @file MappedBinarySearchTree.h
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing variables and method names for the MappedBinarySearchTree class.
+ */
+
+#include <algorithm> // std::equal
+#include <cerrno> // errno
+#include <cstdint> // fixed width integers
+#include <cstring> // std::memcpy
+#include <fcntl.h> // open
+#include <iostream> // << operator
+#include <stdexcept> // std::out_of_range, std::runtime_error
+#include <string> // file paths
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <system_error> // std::system_error
+#include <type_traits> // std::is_trivially_copyable
+#include <unistd.h> // close
+#include "BinarySearchTreeSnapshot.h" // binary snapshot format
+
+#ifndef MAPPEDBINARYSEARCHTREE_H__
+#define MAPPEDBINARYSEARCHTREE_H__
+
+/**
+ * @brief Read-only view of a binary snapshot mapped in memory, written by BinarySearchTree::save.
+ * @tparam TKey Type of node keys, used for ordering. Must be trivially copyable.
+ * @tparam TValue Type of node values. Must be trivially copyable.
+ * @tparam TCompare Type of the custom comparison iterator between nodes. Default std::less<TKey>.
+ *
+ * The snapshot file is mapped with mmap and its sorted key and value arrays are
+ * used in place: opening it costs O(1) regardless of its size, pages are only read
+ * from disk when a search touches them and they are shared between processes
+ * mapping the same file. Lookups are branchless binary searches on the keys.
+ * The checksum is only checked by verify(), since it needs to read the whole file.
+ */
+template <class TKey,class TValue,class TCompare = std::less<TKey>>
+class MappedBinarySearchTree
+{
+	static_assert(std::is_trivially_copyable<TKey>::value && std::is_trivially_copyable<TValue>::value, "Only snapshots of trivially copyable types can be mapped");
+	static_assert(alignof(TKey) <= sizeof(SnapshotFormat::Header) && alignof(TValue) <= SnapshotFormat::valueAlignment, "The snapshot sections are not aligned for these types");
+
+public:
+	/**
+	 * @brief A constant iterator for the mapped binary search tree class.
+	 */
+	class ConstIterator;
+	/** Mapped trees can't be modified, so their iterators are always constant. */
+	using Iterator = ConstIterator;
+
+private:
+	/** The mapped snapshot, nullptr if the tree has been moved. */
+	const char * mapping = nullptr;
+	/** The size in bytes of the mapped snapshot. */
+	std::size_t mappingSize = 0;
+	/** Keys in ascending order, inside the mapping. */
+	const TKey * keys = nullptr;
+	/** Values in ascending key order, inside the mapping. */
+	const TValue * values = nullptr;
+	/** Number of elements of the snapshot. */
+	std::size_t count = 0;
+	/**
+	 * @brief Finds the position of the first element whose key is not less than a key.
+	 * @param key The key to be searched.
+	 * @return std::size_t The position of the element, size() if all keys are less than key.
+	 */
+	std::size_t lowerBoundPosition(const TKey& key) const;
+	/**
+	 * @brief Unmaps the snapshot, if any.
+	 */
+	void unmap();
+
+public:
+	/**
+	 * @brief Constructor for mapped binary search tree from a snapshot file.
+	 * @param path The path of the snapshot file.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 * @throw std::system_error If the file can't be opened or mapped.
+	 * @throw std::runtime_error If the file is not a snapshot of the same types with the expected size.
+	 */
+	explicit MappedBinarySearchTree(const std::string& path, TCompare c = TCompare{});
+	/**
+	 * @brief Mapped trees are not copyable, since they own the mapping.
+	 */
+	MappedBinarySearchTree(const MappedBinarySearchTree&) = delete;
+	/**
+	 * @brief Move constructor, transferring the mapping.
+	 * @param other The tree whose mapping is moved, left empty.
+	 */
+	MappedBinarySearchTree(MappedBinarySearchTree&& other) noexcept;
+	/**
+	 * @brief Mapped trees are not copyable, since they own the mapping.
+	 */
+	MappedBinarySearchTree& operator=(const MappedBinarySearchTree&) = delete;
+	/**
+	 * @brief Move assignment, unmapping the current snapshot and transferring the other mapping.
+	 * @param other The tree whose mapping is moved, left empty.
+	 */
+	MappedBinarySearchTree& operator=(MappedBinarySearchTree&& other) noexcept;
+	/**
+	 * @brief Destructor unmapping the snapshot.
+	 */
+	~MappedBinarySearchTree() { unmap(); }
+	/**
+	 * @brief Returns the number of elements of the tree.
+	 */
+	std::size_t size() const { return count; }
+	/**
+	 * @brief Used to find an element inside the tree.
+	 * @param key The key of the element to be found.
+	 * @return ConstIterator An iterator to the element if it's found, else to end().
+	 */
+	ConstIterator find(const TKey& key) const;
+	/**
+	 * @brief Checks the checksum of the snapshot, reading all its pages.
+	 * @return True if the snapshot is not corrupted, else false.
+	 */
+	bool verify() const;
+	/**
+	 * @brief Prints elements in ascending key order.
+	 * @param os The stream to which elements are sent.
+	 */
+	std::ostream& printOrderedList(std::ostream& os) const;
+	/**
+	 * @brief Used to begin an iteration on the mapped binary search tree.
+	 * @return ConstIterator An iterator to the element with the lowest key.
+	 */
+	ConstIterator begin() const { return ConstIterator{this, 0}; }
+	/**
+	 * @brief Used to finish an iteration on the mapped binary search tree.
+	 * @return ConstIterator An iterator past the element with the highest key.
+	 */
+	ConstIterator end() const { return ConstIterator{this, count}; }
+	/**
+	 * @brief Used to begin an iteration on the mapped binary search tree.
+	 * @return ConstIterator An iterator to the element with the lowest key.
+	 */
+	ConstIterator cbegin() const { return begin(); }
+	/**
+	 * @brief Used to finish an iteration on the mapped binary search tree.
+	 * @return ConstIterator An iterator past the element with the highest key.
+	 */
+	ConstIterator cend() const { return end(); }
+	/**
+	 * @brief Custom comparison operator for the mapped binary search tree.
+	 */
+	TCompare compare;
+	/**
+	 * @brief Operator [] to access an element value in the tree.
+	 * @param key The key of the element which value should be accessed.
+	 * @return const TValue& The value of the accessed element.
+	 * @throw std::out_of_range If the key is not present in the tree.
+	 */
+	const TValue& operator[](const TKey& key) const;
+	/**
+	 * @brief Operator << to print the mapped binary search tree in ascending key order.
+	 * @param os The output stream to which the strings to be printed are appended.
+	 * @param mbst The mapped binary search tree instance to be printed.
+	 * @return std::ostream& The output stream to which strings have been appended.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, MappedBinarySearchTree const& mbst)
+	{
+		return mbst.printOrderedList(os);
+	}
+};
+
+#include "MappedBinarySearchTreeSubclasses.hxx"
+#include "MappedBinarySearchTreeMethods.hxx"
+
+#endif //MAPPEDBINARYSEARCHTREE_H__
@@ -0,0 +1,195 @@
+/**
+ * @file MappedBinarySearchTreeMethods.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing method definitions for the MappedBinarySearchTree class.
+ */
+
+#include "MappedBinarySearchTree.h"
+
+// Private Methods
+
+template <class TKey,class TValue,class TCompare>
+std::size_t MappedBinarySearchTree<TKey, TValue, TCompare>::lowerBoundPosition(const TKey& key) const
+{
+    if(!count)
+    {
+        return 0;
+    }
+    const TKey * base = keys;
+    std::size_t size = count;
+    while(size > 1)
+    {
+        std::size_t half = size / 2;
+        #if defined(__GNUC__)
+        __builtin_prefetch(base + half / 2); // Both halves, the next probe is in one of them
+        __builtin_prefetch(base + half + half / 2);
+        #endif
+        base += compare(base[half], key) ? half : 0; // Branchless descent
+        size -= half;
+    }
+    return (base - keys) + compare(*base, key);
+}
+
+template <class TKey,class TValue,class TCompare>
+void MappedBinarySearchTree<TKey, TValue, TCompare>::unmap()
+{
+    if(mapping)
+    {
+        munmap(const_cast<char *>(mapping), mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    keys = nullptr;
+    values = nullptr;
+    count = 0;
+}
+
+// Public methods
+
+template <class TKey,class TValue,class TCompare>
+MappedBinarySearchTree<TKey, TValue, TCompare>::MappedBinarySearchTree(const std::string& path, TCompare c) : compare{c}
+{
+    int file = open(path.c_str(), O_RDONLY);
+    if(file < 0)
+    {
+        throw std::system_error{errno, std::generic_category(), "The snapshot " + path + " could not be opened"};
+    }
+    struct stat status;
+    if(fstat(file, &status) < 0)
+    {
+        int error = errno;
+        close(file);
+        throw std::system_error{error, std::generic_category(), "The snapshot " + path + " could not be read"};
+    }
+    mappingSize = status.st_size;
+    if(mappingSize < sizeof(SnapshotFormat::Header) + sizeof(std::uint64_t))
+    {
+        close(file);
+        throw std::runtime_error{"The file does not contain a snapshot."};
+    }
+    void * address = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, file, 0);
+    int error = errno;
+    close(file); // The mapping keeps the file open
+    if(address == MAP_FAILED)
+    {
+        throw std::system_error{error, std::generic_category(), "The snapshot " + path + " could not be mapped"};
+    }
+    mapping = static_cast<const char *>(address);
+    SnapshotFormat::Header header;
+    SnapshotFormat::Header expected;
+    std::memcpy(&header, mapping, sizeof(header));
+    const char * message = nullptr;
+    std::uint64_t elementSize = std::uint64_t(sizeof(TKey)) + sizeof(TValue);
+    if(!std::equal(header.magic, header.magic + sizeof(header.magic), expected.magic))
+    {
+        message = "The file does not contain a snapshot.";
+    }
+    else if(header.version != expected.version || header.byteOrder != expected.byteOrder)
+    {
+        message = "The snapshot has an unsupported version or byte order.";
+    }
+    else if(header.keySize != sizeof(TKey) || header.valueSize != sizeof(TValue) || header.keyType != SnapshotFormat::typeTag<TKey>() || header.valueType != SnapshotFormat::typeTag<TValue>())
+    {
+        message = "The snapshot was written for other key or value types.";
+    }
+    else if(header.count > mappingSize / elementSize)
+    {
+        message = "The snapshot is truncated.";
+    }
+    else
+    {
+        std::uint64_t keysEnd = sizeof(header) + header.count * sizeof(TKey);
+        std::uint64_t valuesOffset = keysEnd + SnapshotFormat::padding(keysEnd);
+        if(valuesOffset + header.count * sizeof(TValue) + sizeof(std::uint64_t) != mappingSize)
+        {
+            message = "The snapshot is truncated.";
+        }
+        keys = reinterpret_cast<const TKey *>(mapping + sizeof(header));
+        values = reinterpret_cast<const TValue *>(mapping + valuesOffset);
+        count = header.count;
+    }
+    if(message)
+    {
+        unmap(); // The destructor is not called if the constructor throws
+        throw std::runtime_error{message};
+    }
+}
+
+template <class TKey,class TValue,class TCompare>
+MappedBinarySearchTree<TKey, TValue, TCompare>::MappedBinarySearchTree(MappedBinarySearchTree&& other) noexcept : mapping{other.mapping}, mappingSize{other.mappingSize}, keys{other.keys}, values{other.values}, count{other.count}, compare{std::move(other.compare)}
+{
+    other.mapping = nullptr;
+    other.unmap();
+}
+
+template <class TKey,class TValue,class TCompare>
+typename MappedBinarySearchTree<TKey, TValue, TCompare>::ConstIterator MappedBinarySearchTree<TKey, TValue, TCompare>::find(const TKey& key) const
+{
+    std::size_t position = lowerBoundPosition(key);
+    if(position < count && !compare(key, keys[position]))
+    {
+        return ConstIterator{this, position};
+    }
+    return end();
+}
+
+template <class TKey,class TValue,class TCompare>
+bool MappedBinarySearchTree<TKey, TValue, TCompare>::verify() const
+{
+    if(!mapping)
+    {
+        return true;
+    }
+    std::uint64_t written;
+    std::memcpy(&written, mapping + mappingSize - sizeof(written), sizeof(written));
+    std::size_t size = mappingSize - sizeof(SnapshotFormat::Header) - sizeof(written);
+    return SnapshotFormat::checksum(SnapshotFormat::checksumSeed, mapping + sizeof(SnapshotFormat::Header), size) == written;
+}
+
+template <class TKey,class TValue,class TCompare>
+std::ostream& MappedBinarySearchTree<TKey, TValue, TCompare>::printOrderedList(std::ostream& os) const
+{
+    ConstIterator it{cbegin()};
+    ConstIterator end{cend()};
+    if(it == end)
+    {
+        os << "Empty" << std::endl;
+    }
+    for(; it != end; ++it)
+    {
+        os << (*it).first << ": " << (*it).second << std::endl;
+    }
+    return os;
+}
+
+// Operators
+
+template <class TKey,class TValue,class TCompare>
+MappedBinarySearchTree<TKey, TValue, TCompare>& MappedBinarySearchTree<TKey, TValue, TCompare>::operator=(MappedBinarySearchTree&& other) noexcept
+{
+    if(this != &other)
+    {
+        unmap();
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+        keys = other.keys;
+        values = other.values;
+        count = other.count;
+        compare = std::move(other.compare);
+        other.mapping = nullptr;
+        other.unmap();
+    }
+    return *this;
+}
+
+template <class TKey,class TValue,class TCompare>
+const TValue& MappedBinarySearchTree<TKey, TValue, TCompare>::operator[](const TKey& key) const
+{
+    ConstIterator it{find(key)};
+    if (it == cend())
+    {
+        throw std::out_of_range{"The key is not present in the tree."};
+    }
+    return (*it).second;
+}
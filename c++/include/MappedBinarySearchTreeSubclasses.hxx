@@ -0,0 +1,70 @@
+/**
+ * @file MappedBinarySearchTreeSubclasses.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing the ConstIterator nested class of MappedBinarySearchTree.
+ */
+
+#include "MappedBinarySearchTree.h"
+
+/**
+ * @brief A constant iterator for the mapped binary search tree class.
+ *
+ * Keys and values are stored in separate arrays, so the dereferencing operator
+ * returns a pair of constant references instead of a reference to a pair.
+ */
+template <class TKey,class TValue,class TCompare>
+class MappedBinarySearchTree<TKey, TValue, TCompare>::ConstIterator
+{
+private:
+	/** The tree on which the iteration is performed. */
+	const MappedBinarySearchTree * tree;
+	/** The position of the current element, size() for end(). */
+	std::size_t position;
+public:
+	/**
+	 * @brief Construct an iterator on an element of the tree.
+	 * @param t The tree on which the iterator is constructed.
+	 * @param p The position of the element.
+	 */
+	ConstIterator(const MappedBinarySearchTree * t, std::size_t p) : tree{t}, position{p} {}
+	/**
+	 * @brief Operator it() for deferencing a mapped binary search tree iterator.
+	 * @return std::pair<const TKey&, const TValue&> Constant references to current element's key and value.
+	 */
+	std::pair<const TKey&, const TValue&> operator*() const
+	{
+		return std::pair<const TKey&, const TValue&>{tree->keys[position], tree->values[position]};
+	}
+	/**
+	 * @brief Operator ++it to advance iterator to the next element.
+	 * @return ConstIterator& Reference to an iterator pointing on the next element.
+	 */
+	ConstIterator& operator++()
+	{
+		++position;
+		return *this;
+	}
+	/**
+	 * @brief Operator it++ to advance iterator to the next element.
+	 * @return ConstIterator Value of the current iterator before advancing it to the next element.
+	 */
+	ConstIterator operator++(int)
+	{
+		ConstIterator it{*this};
+		++(*this);
+		return it;
+	}
+	/**
+	 * @brief Operator == to check for iterators equality.
+	 * @param other The iterator to be compared with this one.
+	 * @return True if iterators point to the same element, else false
+	 */
+	bool operator==(const ConstIterator& other) const { return position == other.position; }
+	/**
+	 * @brief Operator != to check for iterators inequality.
+	 * @param other The iterator to be compared with this one.
+	 * @return False if iterators point to the same element, else true.
+	 */
+	bool operator!=(const ConstIterator& other) const { return position != other.position; }
+};
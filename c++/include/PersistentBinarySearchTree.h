@@ -0,0 +1,205 @@
+/**
+ * @file PersistentBinarySearchTree.h
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing variables and method names for the PersistentBinarySearchTree class.
+ */
+
+#include <iostream> // << operator
+#include <memory> // shared pointers
+#include <stdexcept> // std::out_of_range
+#include <tuple> // std::forward_as_tuple
+#include <utility> // std::pair, std::as_const
+#include <vector> // iterator stacks
+
+#ifndef PERSISTENTBINARYSEARCHTREE_H__
+#define PERSISTENTBINARYSEARCHTREE_H__
+
+/**
+ * @brief Persistent red-black binary search tree, whose copies share their nodes.
+ * @tparam TKey Type of node keys, used for ordering.
+ * @tparam TValue Type of node values.
+ * @tparam TCompare Type of the custom comparison iterator between nodes. Default std::less<TKey>.
+ *
+ * Nodes are never modified once they are reachable from a tree, so copies and
+ * snapshots only share the root in O(1) time. A modification copies the O(log n)
+ * nodes on the path from the root to the changed one and rebalances the copies
+ * as in Okasaki's red-black insertion, leaving every other version untouched.
+ * Nodes are reference counted, so those only reachable from dropped versions
+ * are released with the last of them.
+ * Different versions can be used by different threads at the same time, for
+ * example readers searching a snapshot while a writer keeps inserting into the
+ * tree, but a single version must not be modified while it is copied or read.
+ */
+template <class TKey,class TValue,class TCompare = std::less<TKey>>
+class PersistentBinarySearchTree
+{
+private:
+	/**
+	 * @brief A node of the tree, shared between versions.
+	 */
+	struct Node;
+	/** Shared pointer to a node. */
+	using NodePtr = std::shared_ptr<Node>;
+
+public:
+	/**
+	 * @brief A constant iterator for the persistent binary search tree class.
+	 */
+	class ConstIterator;
+	/** Nodes are shared between versions and can't be modified, so iterators are always constant. */
+	using Iterator = ConstIterator;
+	/** Type of node keys, named as in the standard associative containers. */
+	using key_type = TKey;
+	/** Type of node values, named as in the standard associative containers. */
+	using mapped_type = TValue;
+	/** Type of the key,value pairs stored in the nodes. */
+	using value_type = std::pair<const TKey, TValue>;
+
+private:
+	/** Root node of this version of the tree. */
+	NodePtr root;
+	/** Number of nodes of this version of the tree. */
+	std::size_t nodeCount = 0;
+	/**
+	 * @brief Inserts an element in a subtree, copying the nodes on the path to it.
+	 * @tparam TAssign Whether the value of an element with the same key is replaced.
+	 * @param node The root of the subtree.
+	 * @param key The key of the element.
+	 * @param inserted Set to true if a new node was created.
+	 * @param args The arguments forwarded to the node constructor, only used if a node is created.
+	 * @return NodePtr The root of the new version of the subtree, node itself if nothing changed.
+	 */
+	template <bool TAssign, class... TArgs>
+	NodePtr insertNode(const NodePtr& node, const TKey& key, bool& inserted, TArgs&&... args) const;
+	/**
+	 * @brief Fixes a red node with a red child below a black node, by relinking the three nodes.
+	 * @param node The black node, whose red descendants must be copies not shared with other versions.
+	 * @return NodePtr The root of the rebalanced subtree.
+	 */
+	static NodePtr balance(NodePtr node);
+	/**
+	 * @brief Inserts an element and updates the root.
+	 * @tparam TAssign Whether the value of an element with the same key is replaced.
+	 * @param key The key of the element.
+	 * @param args The arguments forwarded to the node constructor, only used if a node is created.
+	 * @return True if a new node was created, else false.
+	 */
+	template <bool TAssign, class... TArgs>
+	bool insertRoot(const TKey& key, TArgs&&... args);
+
+public:
+	/**
+	 * @brief Default constructor for an empty persistent binary search tree.
+	 */
+	PersistentBinarySearchTree() {}
+	/**
+	 * @brief Constructor for persistent binary search tree with a single element.
+	 * @param d The key,value pair of the element.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 */
+	PersistentBinarySearchTree(std::pair<TKey, TValue> d, TCompare c = TCompare{}) : compare{c} { insert(std::move(d)); }
+	/**
+	 * @brief Constructor for persistent binary search tree from a range.
+	 * @param first The iterator to the first key,value pair of the range.
+	 * @param last The iterator past the last key,value pair of the range.
+	 * @param c The custom comparison function for tree nodes, not mandatory.
+	 */
+	template <class TInputIterator>
+	PersistentBinarySearchTree(TInputIterator first, TInputIterator last, TCompare c = TCompare{});
+	/**
+	 * @brief Returns a snapshot of the tree in O(1) time, sharing all its nodes.
+	 * @return PersistentBinarySearchTree The snapshot, unaffected by later modifications of this tree.
+	 *
+	 * It is equivalent to the copy constructor, which shares the nodes as well.
+	 */
+	PersistentBinarySearchTree snapshot() const { return *this; }
+	/**
+	 * @brief Used to insert a new element in the tree, in O(log n) time and space.
+	 * @param d The key,value pair to be inserted.
+	 * @return True if the element was inserted, false if the key was already present.
+	 */
+	bool insert(const std::pair<TKey, TValue>& d) { return insertRoot<false>(d.first, d); }
+	/**
+	 * @brief Used to insert a new element in the tree, moving it, in O(log n) time and space.
+	 * @param d The key,value pair to be inserted.
+	 * @return True if the element was inserted, false if the key was already present.
+	 */
+	bool insert(std::pair<TKey, TValue>&& d) { return insertRoot<false>(d.first, std::move(d)); }
+	/**
+	 * @brief Inserts an element or replaces the value of the element with the same key, in O(log n) time and space.
+	 * @param key The key of the element.
+	 * @param value The new value of the element.
+	 * @return True if the element was inserted, false if its value was replaced.
+	 */
+	bool insert_or_assign(const TKey& key, const TValue& value) { return insertRoot<true>(key, key, value); }
+	/**
+	 * @brief Empties this version of the tree, the nodes are released when no other version shares them.
+	 */
+	void clear()
+	{
+		root.reset();
+		nodeCount = 0;
+	}
+	/**
+	 * @brief Returns the number of nodes of the tree, in constant time.
+	 */
+	std::size_t size() const { return nodeCount; }
+	/**
+	 * @brief Prints elements in ascending key order.
+	 * @param os The stream to which elements are sent.
+	 */
+	std::ostream& printOrderedList(std::ostream& os) const;
+	/**
+	 * @brief Used to find an element inside the tree.
+	 * @param key The key of the element to be found.
+	 * @return ConstIterator An iterator to the element if it's found, else to end().
+	 */
+	ConstIterator find(const TKey& key) const;
+	/**
+	 * @brief Used to begin an iteration on the persistent binary search tree.
+	 * @return ConstIterator An iterator to the node with the lowest key, valid as long as this version is not modified or destroyed.
+	 */
+	ConstIterator begin() const;
+	/**
+	 * @brief Used to finish an iteration on the persistent binary search tree.
+	 * @return ConstIterator An iterator past the node with the highest key.
+	 */
+	ConstIterator end() const { return ConstIterator{}; }
+	/**
+	 * @brief Used to begin an iteration on the persistent binary search tree.
+	 * @return ConstIterator An iterator to the node with the lowest key, valid as long as this version is not modified or destroyed.
+	 */
+	ConstIterator cbegin() const { return begin(); }
+	/**
+	 * @brief Used to finish an iteration on the persistent binary search tree.
+	 * @return ConstIterator An iterator past the node with the highest key.
+	 */
+	ConstIterator cend() const { return end(); }
+	/**
+	 * @brief Custom comparison operator for the persistent binary search tree.
+	 */
+	TCompare compare;
+	/**
+	 * @brief Operator [] to access an element value in the tree.
+	 * @param key The key of the element which value should be accessed.
+	 * @return const TValue& The value of the accessed element.
+	 * @throw std::out_of_range If the key is not present in the tree.
+	 */
+	const TValue& operator[](const TKey& key) const;
+	/**
+	 * @brief Operator << to print the persistent binary search tree in ascending key order.
+	 * @param os The output stream to which the strings to be printed are appended.
+	 * @param pbst The persistent binary search tree instance to be printed.
+	 * @return std::ostream& The output stream to which strings have been appended.
+	 */
+	friend std::ostream& operator<<(std::ostream& os, PersistentBinarySearchTree const& pbst)
+	{
+		return pbst.printOrderedList(os);
+	}
+};
+
+#include "PersistentBinarySearchTreeSubclasses.hxx"
+#include "PersistentBinarySearchTreeMethods.hxx"
+
+#endif //PERSISTENTBINARYSEARCHTREE_H__
@@ -0,0 +1,196 @@
+/**
+ * @file PersistentBinarySearchTreeMethods.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing method definitions for the PersistentBinarySearchTree class.
+ */
+
+#include "PersistentBinarySearchTree.h"
+
+// Private Methods
+
+template <class TKey,class TValue,class TCompare>
+template <bool TAssign, class... TArgs>
+typename PersistentBinarySearchTree<TKey, TValue, TCompare>::NodePtr PersistentBinarySearchTree<TKey, TValue, TCompare>::insertNode(const NodePtr& node, const TKey& key, bool& inserted, TArgs&&... args) const
+{
+    if(!node)
+    {
+        inserted = true;
+        return std::make_shared<Node>(std::forward<TArgs>(args)...);
+    }
+    bool left = compare(key, node->data.first);
+    if(!left && !compare(node->data.first, key)) // Element already present
+    {
+        if constexpr(TAssign)
+        {
+            NodePtr copy{std::make_shared<Node>(std::as_const(*node))};
+            copy->data.second = std::get<sizeof...(TArgs) - 1>(std::forward_as_tuple(args...)); // The value is the last argument
+            return copy;
+        }
+        return node;
+    }
+    const NodePtr& child = left ? node->left : node->right;
+    NodePtr newChild{insertNode<TAssign>(child, key, inserted, std::forward<TArgs>(args)...)};
+    if(newChild == child) // Nothing changed below, the subtree is still shared
+    {
+        return node;
+    }
+    NodePtr copy{std::make_shared<Node>(std::as_const(*node))}; // Path copying
+    (left ? copy->left : copy->right) = std::move(newChild);
+    return inserted ? balance(std::move(copy)) : copy;
+}
+
+template <class TKey,class TValue,class TCompare>
+typename PersistentBinarySearchTree<TKey, TValue, TCompare>::NodePtr PersistentBinarySearchTree<TKey, TValue, TCompare>::balance(NodePtr node)
+{
+    // The red nodes involved are on the path of the insertion, so they are
+    // fresh copies which can be relinked in place without copying them again.
+    if(node->red)
+    {
+        return node;
+    }
+    NodePtr top, low, high; // The three nodes in key order are linked as low <- top -> high
+    if(node->left && node->left->red && node->left->left && node->left->left->red)
+    {
+        top = node->left;
+        low = top->left;
+        high = node;
+        high->left = std::move(top->right);
+    }
+    else if(node->left && node->left->red && node->left->right && node->left->right->red)
+    {
+        low = node->left;
+        top = low->right;
+        high = node;
+        low->right = std::move(top->left);
+        high->left = std::move(top->right);
+    }
+    else if(node->right && node->right->red && node->right->left && node->right->left->red)
+    {
+        low = node;
+        high = node->right;
+        top = high->left;
+        low->right = std::move(top->left);
+        high->left = std::move(top->right);
+    }
+    else if(node->right && node->right->red && node->right->right && node->right->right->red)
+    {
+        low = node;
+        top = node->right;
+        high = top->right;
+        low->right = std::move(top->left);
+    }
+    else
+    {
+        return node;
+    }
+    top->left = low;
+    top->right = high;
+    top->red = true;
+    low->red = false;
+    high->red = false;
+    return top;
+}
+
+template <class TKey,class TValue,class TCompare>
+template <bool TAssign, class... TArgs>
+bool PersistentBinarySearchTree<TKey, TValue, TCompare>::insertRoot(const TKey& key, TArgs&&... args)
+{
+    bool inserted = false;
+    NodePtr newRoot{insertNode<TAssign>(root, key, inserted, std::forward<TArgs>(args)...)};
+    if(newRoot != root)
+    {
+        if(newRoot->red) // Only a fresh copy can be red at the root
+        {
+            newRoot->red = false;
+        }
+        root = std::move(newRoot);
+    }
+    nodeCount += inserted;
+    return inserted;
+}
+
+// Public methods
+
+template <class TKey,class TValue,class TCompare>
+template <class TInputIterator>
+PersistentBinarySearchTree<TKey, TValue, TCompare>::PersistentBinarySearchTree(TInputIterator first, TInputIterator last, TCompare c) : compare{c}
+{
+    for(; first != last; ++first)
+    {
+        insert(*first);
+    }
+}
+
+template <class TKey,class TValue,class TCompare>
+std::ostream& PersistentBinarySearchTree<TKey, TValue, TCompare>::printOrderedList(std::ostream& os) const
+{
+    ConstIterator it{cbegin()};
+    ConstIterator end{cend()};
+    if(it == end)
+    {
+        os << "Empty" << std::endl;
+    }
+    for(; it != end; ++it)
+    {
+        os << (*it).first << ": " << (*it).second << std::endl;
+    }
+    return os;
+}
+
+template <class TKey,class TValue,class TCompare>
+typename PersistentBinarySearchTree<TKey, TValue, TCompare>::ConstIterator PersistentBinarySearchTree<TKey, TValue, TCompare>::find(const TKey& key) const
+{
+    ConstIterator it;
+    const Node * node = root.get();
+    while(node)
+    {
+        if(compare(key, node->data.first))
+        {
+            it.stack.push_back(node); // Visited again after the left subtree
+            node = node->left.get();
+        }
+        else if(compare(node->data.first, key))
+        {
+            node = node->right.get();
+        }
+        else
+        {
+            it.stack.push_back(node);
+            return it;
+        }
+    }
+    return end();
+}
+
+template <class TKey,class TValue,class TCompare>
+typename PersistentBinarySearchTree<TKey, TValue, TCompare>::ConstIterator PersistentBinarySearchTree<TKey, TValue, TCompare>::begin() const
+{
+    ConstIterator it;
+    it.pushLeftmost(root.get());
+    return it;
+}
+
+// Operators
+
+template <class TKey,class TValue,class TCompare>
+const TValue& PersistentBinarySearchTree<TKey, TValue, TCompare>::operator[](const TKey& key) const
+{
+    const Node * node = root.get();
+    while(node)
+    {
+        if(compare(key, node->data.first))
+        {
+            node = node->left.get();
+        }
+        else if(compare(node->data.first, key))
+        {
+            node = node->right.get();
+        }
+        else
+        {
+            return node->data.second;
+        }
+    }
+    throw std::out_of_range{"The key is not present in the tree."};
+}
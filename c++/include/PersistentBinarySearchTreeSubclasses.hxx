@@ -0,0 +1,102 @@
+/**
+ * @file PersistentBinarySearchTreeSubclasses.hxx
+ * @author Gabriele Sarti
+ * @date 17 October 2026
+ * @brief Header containing Node and ConstIterator nested classes of PersistentBinarySearchTree.
+ */
+
+#include "PersistentBinarySearchTree.h"
+
+template <class TKey,class TValue,class TCompare>
+struct PersistentBinarySearchTree<TKey, TValue, TCompare>::Node
+{
+	/** Key,value pair of the node. */
+	std::pair<const TKey, TValue> data;
+	/** Left child, shared between versions. */
+	NodePtr left;
+	/** Right child, shared between versions. */
+	NodePtr right;
+	/** Colour of the node, new nodes are red. */
+	bool red = true;
+	/**
+	 * @brief Constructor for a new red node without children.
+	 * @param args The arguments forwarded to the key,value pair constructor.
+	 */
+	template <class... TArgs>
+	explicit Node(TArgs&&... args) : data(std::forward<TArgs>(args)...) {}
+	/**
+	 * @brief Copy constructor, sharing the children of the copied node.
+	 */
+	Node(const Node&) = default;
+};
+
+/**
+ * @brief A constant iterator for the persistent binary search tree class.
+ *
+ * Nodes have no parent pointers, since they can have a different parent
+ * in every version, so the iterator keeps the ancestors still to be visited.
+ */
+template <class TKey,class TValue,class TCompare>
+class PersistentBinarySearchTree<TKey, TValue, TCompare>::ConstIterator
+{
+private:
+	friend class PersistentBinarySearchTree;
+	/** The current node, on top, and its ancestors whose left subtree contains it. */
+	std::vector<const Node *> stack;
+	/**
+	 * @brief Pushes a node and the leftmost path of its subtree.
+	 * @param node The root of the subtree.
+	 */
+	void pushLeftmost(const Node * node)
+	{
+		for(; node; node = node->left.get())
+		{
+			stack.push_back(node);
+		}
+	}
+public:
+	/**
+	 * @brief Operator it() for deferencing a persistent binary search tree iterator.
+	 * @return const std::pair<const TKey, TValue>& Constant reference to current node's data.
+	 */
+	const std::pair<const TKey, TValue>& operator*() const { return stack.back()->data; }
+	/**
+	 * @brief Operator ++it to advance iterator to the next node.
+	 * @return ConstIterator& Reference to an iterator pointing on the next node.
+	 */
+	ConstIterator& operator++()
+	{
+		if(!stack.empty())
+		{
+			const Node * node = stack.back();
+			stack.pop_back();
+			pushLeftmost(node->right.get());
+		}
+		return *this;
+	}
+	/**
+	 * @brief Operator it++ to advance iterator to the next node.
+	 * @return ConstIterator Value of the current iterator before advancing it to the next node.
+	 */
+	ConstIterator operator++(int)
+	{
+		ConstIterator it{*this};
+		++(*this);
+		return it;
+	}
+	/**
+	 * @brief Operator == to check for iterators equality.
+	 * @param other The iterator to be compared with this one.
+	 * @return True if iterators point to the same node, else false
+	 */
+	bool operator==(const ConstIterator& other) const
+	{
+		return (stack.empty() ? nullptr : stack.back()) == (other.stack.empty() ? nullptr : other.stack.back());
+	}
+	/**
+	 * @brief Operator != to check for iterators inequality.
+	 * @param other The iterator to be compared with this one.
+	 * @return False if iterators point to the same node, else true.
+	 */
+	bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+};
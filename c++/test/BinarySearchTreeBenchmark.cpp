@@ -6,38 +6,89 @@
  */
 
 #include "BinarySearchTree.h"
+#include "BPlusTree.h"
+#include "ConcurrentBinarySearchTree.h"
+#include "MappedBinarySearchTree.h"
+#include "PersistentBinarySearchTree.h"
 #include <memory>
 #include <algorithm>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <cstdlib>
+#include <new>
 #include <cmath>
 #include <map>
 #include <unordered_map>
 #include <chrono>
+#include <cstdio>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 using namespace std;
 
 int N_max=20000; 
 
+// Global operator new and delete are replaced to keep track of the number of allocations
+// and of the peak of allocated bytes. The size of every block is stored before it.
+// The counters are atomic since the concurrent and parallel benchmarks allocate from many threads.
+atomic<size_t> allocations{0};
+atomic<size_t> allocatedBytes{0};
+atomic<size_t> peakAllocatedBytes{0};
+
+void* operator new(size_t size){
+	allocations.fetch_add(1,memory_order_relaxed);
+	size_t current=allocatedBytes.fetch_add(size,memory_order_relaxed)+size;
+	size_t peak=peakAllocatedBytes.load(memory_order_relaxed);
+	while(peak<current && !peakAllocatedBytes.compare_exchange_weak(peak,current,memory_order_relaxed)){
+	}
+	size_t* block=static_cast<size_t*>(malloc(size+alignof(max_align_t)));
+	if(!block){
+		throw bad_alloc{};
+	}
+	*block=size;
+	return reinterpret_cast<char*>(block)+alignof(max_align_t);
+}
+
+void operator delete(void* p) noexcept{
+	if(p){
+		size_t* block=reinterpret_cast<size_t*>(static_cast<char*>(p)-alignof(max_align_t));
+		allocatedBytes.fetch_sub(*block,memory_order_relaxed);
+		free(block);
+	}
+}
+
+void operator delete(void* p, size_t) noexcept{
+	operator delete(p);
+}
+
 // First benchmark: Define 2 BinarySearchTree of int,float. The function will measure time 
 // for find() methods for different N size of the trees and print the result on file. 
 // Input: string with "int"/"float" type of pair<type,type> (for semplicity we consider
 // just one type for couple value-key),empty BinarySearchTree.
-// Accessing element using operator[], so we expect an overestimation.
+// The tree is taken by reference, so that it is not copied before measuring, and times are
+// in nanoseconds. See BinarySearchTreeSuite.cpp for repeated trials on several workloads.
+
+// Keeps the results of the measured lookups alive, so that the compiler can't remove them.
+volatile size_t found=0;
 
 template<class myType>
-void Timing(myType B,ofstream& myfile){
-        myfile<<"N   total time    time per operation   Log(N)"<<endl;
+void Timing(const myType& B,ofstream& myfile){
+        myfile<<"N   total time (ns)    time per operation   Log(N)"<<endl;
         for(int j=0;j<N_max;j+=50){
+        size_t hits=0;
         auto begin = chrono::high_resolution_clock::now();
                 for(int i=0;i<j;++i){
-                        B.find(i);
+                        hits+=B.find(i)!=B.end();
                 }
         auto end = chrono::high_resolution_clock::now();
-        auto total=chrono::duration_cast<chrono::microseconds>(end-begin).count();
+        found=found+hits;
+        auto total=chrono::duration_cast<chrono::nanoseconds>(end-begin).count();
         myfile<<j<<"        "<<total<<"         "<<total/double(j)<<"       "<<log2(total/double(j)) <<endl;
         }
 
@@ -68,14 +119,16 @@ void Benchmark_different_type(string type){
                 }
                 cout<<"Accessing Elements for double type."<<endl;
                 myfile<<"Accessing Elements for double type."<<endl;
-		myfile<<"N   total time    time per operation   Log(N)"<<endl;
+		myfile<<"N   total time (ns)    time per operation   Log(N)"<<endl;
                 for(int j=0;j<N_max;j+=50){
+                        size_t hits=0;
                         auto begin = chrono::high_resolution_clock::now();
                         for(int i=0;i<j;++i){
-				b.find(val[i]);
+				hits+=b.find(val[i])!=b.end();
                         }
                         auto end = chrono::high_resolution_clock::now();
-                        auto total=chrono::duration_cast<chrono::microseconds>(end-begin).count();
+                        found=found+hits;
+                        auto total=chrono::duration_cast<chrono::nanoseconds>(end-begin).count();
                         myfile<<j<<"        "<<total<<"         "<<total/double(j)<<"       "<<log2(total/double(j)) <<endl;
                 }
 		myfile.close();
@@ -83,7 +136,8 @@ void Benchmark_different_type(string type){
 
 };
 
-//Comparing unbalanced BinarySearchTree, balanced BinarySearchTree,map and unordered_map.
+//Comparing unbalanced BinarySearchTree, balanced BinarySearchTree, self-balancing (AVL and red-black)
+//BinarySearchTree loaded with sequential keys, map and unordered_map.
 void Benchmark_Map(){
 	ofstream myfile;
         myfile.open ("test/benchmark_results/benchmark_unbalanced.txt");
@@ -99,6 +153,21 @@ void Benchmark_Map(){
 	b.balance();
 	Timing(b,myfile1);
 	myfile1.close();
+	BinarySearchTree<int,int,less<int>,AVLBalancing> avl;
+	BinarySearchTree<int,int,less<int>,RedBlackBalancing> redBlack;
+	for(int i=0;i<N_max;++i){
+		pair<int, int> pair{i,i};
+		avl.insert(pair);
+		redBlack.insert(pair);
+	}
+	ofstream myfileAVL;
+	myfileAVL.open ("test/benchmark_results/benchmark_avl.txt");
+	Timing(avl,myfileAVL);
+	myfileAVL.close();
+	ofstream myfileRB;
+	myfileRB.open ("test/benchmark_results/benchmark_red_black.txt");
+	Timing(redBlack,myfileRB);
+	myfileRB.close();
 	map<int,int> Bench;
 	ofstream myfile2;
         myfile2.open ("test/benchmark_results/benchmark_map.txt");
@@ -119,10 +188,653 @@ void Benchmark_Map(){
         myfile3.close();
 };
 
+// Comparing insert throughput and lookup latency of nodes created one by one on the heap
+// and nodes created inside pool chunks, for random keys on red-black balanced trees.
+template<class myTree>
+void Timing_allocation(const vector<int>& keys,ofstream& myfile){
+	myfile<<"N   insert time per operation   find time per operation"<<endl;
+	for(size_t j=1000;j<=keys.size();j*=10){
+		myTree b;
+		auto begin = chrono::high_resolution_clock::now();
+		for(size_t i=0;i<j;++i){
+			b.insert(pair<int, int>{keys[i],keys[i]});
+		}
+		auto end = chrono::high_resolution_clock::now();
+		auto insertTotal=chrono::duration_cast<chrono::nanoseconds>(end-begin).count();
+		begin = chrono::high_resolution_clock::now();
+		long found=0;
+		for(size_t i=0;i<j;++i){
+			found+=(*b.find(keys[j-1-i])).second;
+		}
+		end = chrono::high_resolution_clock::now();
+		auto findTotal=chrono::duration_cast<chrono::nanoseconds>(end-begin).count();
+		myfile<<j<<"        "<<insertTotal/double(j)<<"         "<<findTotal/double(j)<<"       "<<(found>0)<<endl;
+	}
+};
+
+void Benchmark_allocation(){
+	vector<int> keys;
+	for(int i=0;i<1000000;++i){
+		keys.push_back(rand());
+	}
+	cout<<"Comparing heap and pool allocation."<<endl;
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_heap_allocation.txt");
+	Timing_allocation<BinarySearchTree<int,int,less<int>,RedBlackBalancing,HeapAllocation>>(keys,myfile);
+	myfile.close();
+	ofstream myfile1;
+	myfile1.open ("test/benchmark_results/benchmark_pool_allocation.txt");
+	Timing_allocation<BinarySearchTree<int,int,less<int>,RedBlackBalancing,PoolAllocation<>>>(keys,myfile1);
+	myfile1.close();
+};
+
+// Measuring time and peak of additional memory needed by balance() on unbalanced trees
+// with heavy values, since nodes are relinked in place no memory should be allocated.
+void Benchmark_balance(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_balance.txt");
+	cout<<"Balancing trees with heavy values."<<endl;
+	myfile<<"N   balance time    time per node   peak additional bytes"<<endl;
+	for(int j=1000;j<=1000000;j*=10){
+		BinarySearchTree<int,vector<double>> b;
+		for(int i=0;i<j;++i){
+			int x=rand();
+			b.insert(pair<int, vector<double>>{x,vector<double>(64,x)});
+		}
+		size_t initialBytes=allocatedBytes;
+		peakAllocatedBytes.store(allocatedBytes.load());
+		auto begin = chrono::high_resolution_clock::now();
+		b.balance();
+		auto end = chrono::high_resolution_clock::now();
+		auto total=chrono::duration_cast<chrono::microseconds>(end-begin).count();
+		myfile<<j<<"        "<<total<<"         "<<total/double(j)<<"       "<<peakAllocatedBytes-initialBytes<<endl;
+	}
+	myfile.close();
+};
+
+// Measuring load time of 10M sorted keys: bulk load from the sorted range, hinted insertion
+// at end() followed by balance(), hinted insertion at end() on a red-black tree and map with end() hints.
+template<class myType>
+double Timing_load(const vector<pair<int,int>>& sorted,myType& b){
+	auto begin = chrono::high_resolution_clock::now();
+	for(size_t i=0;i<sorted.size();++i){
+		b.insert(b.end(),sorted[i]);
+	}
+	auto end = chrono::high_resolution_clock::now();
+	return chrono::duration_cast<chrono::milliseconds>(end-begin).count();
+};
+
+void Benchmark_sorted_load(){
+	const int N=10000000;
+	vector<pair<int,int>> sorted;
+	for(int i=0;i<N;++i){
+		sorted.push_back(pair<int,int>{i,i});
+	}
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_sorted_load.txt");
+	cout<<"Loading sorted keys."<<endl;
+	myfile<<"Load time in milliseconds for "<<N<<" sorted keys"<<endl;
+	{
+		BinarySearchTree<int,int> b;
+		double total=Timing_load(sorted,b);
+		auto begin = chrono::high_resolution_clock::now();
+		b.balance();
+		auto end = chrono::high_resolution_clock::now();
+		myfile<<"BinarySearchTree end() hint+balance   "<<total+chrono::duration_cast<chrono::milliseconds>(end-begin).count()<<endl;
+	}
+	{
+		BinarySearchTree<int,int,less<int>,RedBlackBalancing> b;
+		myfile<<"Red-black BinarySearchTree end() hint "<<Timing_load(sorted,b)<<endl;
+	}
+	{
+		map<int,int> b;
+		myfile<<"map end() hint                        "<<Timing_load(sorted,b)<<endl;
+	}
+	{
+		auto begin = chrono::high_resolution_clock::now();
+		BinarySearchTree<int,int> b{sorted.begin(),sorted.end()};
+		auto end = chrono::high_resolution_clock::now();
+		myfile<<"BinarySearchTree bulk load            "<<chrono::duration_cast<chrono::milliseconds>(end-begin).count()<<endl;
+	}
+	myfile.close();
+};
+
+// Measuring random lookups time per operation in nanoseconds on balanced BinarySearchTree, frozen
+// BinarySearchTree, map and unordered_map, with sizes from fitting L1 cache to far beyond the last level cache.
+template<class myType>
+double Timing_lookup(const myType& b,const vector<int>& queries){
+	long found=0;
+	auto begin = chrono::high_resolution_clock::now();
+	for(size_t i=0;i<queries.size();++i){
+		found+=(*b.find(queries[i])).second;
+	}
+	auto end = chrono::high_resolution_clock::now();
+	if(found<0){
+		cout<<found<<endl; // Prevents the compiler from removing the lookups
+	}
+	return chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(queries.size());
+};
+
+void Benchmark_frozen(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_frozen.txt");
+	cout<<"Comparing frozen trees lookups."<<endl;
+	myfile<<"N   balanced tree   frozen tree   map   unordered_map (ns per lookup)"<<endl;
+	for(int j=1<<10;j<=1<<23;j*=4){
+		vector<pair<int,int>> sorted;
+		for(int i=0;i<j;++i){
+			sorted.push_back(pair<int,int>{2*i,i});
+		}
+		vector<int> queries;
+		for(int i=0;i<1000000;++i){
+			queries.push_back(2*(rand()%j));
+		}
+		BinarySearchTree<int,int> b{sorted.begin(),sorted.end()};
+		myfile<<j<<"        "<<Timing_lookup(b,queries)<<"         ";
+		FrozenBinarySearchTree<int,int> frozen{b.freeze()};
+		b.clear();
+		myfile<<Timing_lookup(frozen,queries)<<"         ";
+		map<int,int> m{sorted.begin(),sorted.end()};
+		myfile<<Timing_lookup(m,queries)<<"         ";
+		m.clear();
+		unordered_map<int,int> u{sorted.begin(),sorted.end()};
+		myfile<<Timing_lookup(u,queries)<<endl;
+	}
+	myfile.close();
+};
+
+// Comparing random lookups performed with a loop over find() and with find_many(),
+// on balanced trees with random keys much larger than the cache.
+void Benchmark_find_many(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_find_many.txt");
+	cout<<"Comparing batched lookups."<<endl;
+	myfile<<"N   find loop   find_many (ns per lookup)"<<endl;
+	for(int j=1<<16;j<=1<<22;j*=4){
+		BinarySearchTree<int,int,less<int>,RedBlackBalancing,PoolAllocation<>> b;
+		vector<int> keys;
+		for(int i=0;i<j;++i){
+			int x=rand();
+			b.insert(pair<int, int>{x,x});
+			keys.push_back(x);
+		}
+		vector<int> queries;
+		for(int i=0;i<1000000;++i){
+			queries.push_back(keys[rand()%j]);
+		}
+		myfile<<j<<"        "<<Timing_lookup(b,queries)<<"         ";
+		vector<BinarySearchTree<int,int,less<int>,RedBlackBalancing,PoolAllocation<>>::Iterator> results;
+		results.reserve(queries.size());
+		auto begin = chrono::high_resolution_clock::now();
+		b.find_many(queries.begin(),queries.end(),back_inserter(results));
+		auto end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(queries.size())<<endl;
+	}
+	myfile.close();
+};
+
+// Comparing percentiles and range counts on std::map, by scanning, and on an order statistic tree.
+void Benchmark_order_statistics(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_order_statistics.txt");
+	cout<<"Comparing percentile and range count queries."<<endl;
+	myfile<<"N   map percentile   tree percentile   map range count   tree range count (ns per query)"<<endl;
+	for(int j=1<<12;j<=1<<18;j*=4){
+		BinarySearchTree<int,int,less<int>,RedBlackBalancing,PoolAllocation<>,OrderStatistics> b;
+		map<int,int> m;
+		for(int i=0;i<j;++i){
+			int x=rand();
+			b.insert(pair<int, int>{x,x});
+			m.insert(pair<int, int>{x,x});
+		}
+		int queries=1000;
+		long long check=0;
+		auto begin = chrono::high_resolution_clock::now();
+		for(int i=0;i<queries;++i){
+			auto it=m.begin();
+			advance(it,m.size()*(i%100)/100); // percentile by scanning
+			check+=it->first;
+		}
+		auto end = chrono::high_resolution_clock::now();
+		myfile<<j<<"        "<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(queries)<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		for(int i=0;i<queries;++i){
+			check-=(*b.select(m.size()*(i%100)/100)).first;
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(queries)<<"         ";
+		vector<pair<int,int>> ranges;
+		for(int i=0;i<queries;++i){
+			int x=rand(),y=rand();
+			ranges.push_back({min(x,y),max(x,y)});
+		}
+		begin = chrono::high_resolution_clock::now();
+		for(auto& r:ranges){
+			check+=distance(m.lower_bound(r.first),m.lower_bound(r.second));
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(queries)<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		for(auto& r:ranges){
+			check-=b.count_range(r.first,r.second);
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(queries)<<endl;
+		if(check){
+			cout<<"Order statistics differ from the map ones."<<endl;
+		}
+	}
+	myfile.close();
+};
+
+void Benchmark_set_operations(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_set_operations.txt");
+	cout<<"Comparing ways of merging two trees."<<endl;
+	myfile<<"N   reinsertion   merge   set_union   split+join (ms)"<<endl;
+	using myTree=BinarySearchTree<int,int,less<int>,RedBlackBalancing>;
+	for(int j=1<<16;j<=1<<20;j*=4){
+		myTree a,b;
+		for(int i=0;i<j;++i){
+			int x=rand();
+			a.insert(pair<int, int>{x,x});
+			x=rand();
+			b.insert(pair<int, int>{x,x});
+		}
+		myTree target{a};
+		auto begin = chrono::high_resolution_clock::now();
+		for(auto& p:b){
+			target.insert(p);
+		}
+		auto end = chrono::high_resolution_clock::now();
+		myfile<<j<<"        "<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		myTree merged{a};
+		myTree source{b};
+		begin = chrono::high_resolution_clock::now();
+		merged.merge(move(source));
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		myTree united{a.set_union(b)};
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		myTree greater{merged.split(RAND_MAX/2)};
+		merged.join(move(greater));
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<endl;
+	}
+	myfile.close();
+};
+
+void Benchmark_parallel(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_parallel.txt");
+	cout<<"Comparing parallel balance and reduction."<<endl;
+	myfile<<"Threads   balance   parallel_balance   iteration sum   parallel_reduce sum (ms)"<<endl;
+	int n=1<<22;
+	int maxThreads=max(2u,thread::hardware_concurrency());
+	BinarySearchTree<int,long,less<int>,NoBalancing,PoolAllocation<>> b;
+	for(int i=0;i<n;++i){
+		int x=rand();
+		b.insert(pair<int, long>{x,x});
+	}
+	for(int threads=1;threads<=maxThreads;threads*=2){
+		auto copy=b; // Same random shape for every measure
+		auto begin = chrono::high_resolution_clock::now();
+		copy.balance();
+		auto end = chrono::high_resolution_clock::now();
+		myfile<<threads<<"        "<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		copy=b;
+		begin = chrono::high_resolution_clock::now();
+		copy.parallel_balance(threads);
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		long sum=0;
+		begin = chrono::high_resolution_clock::now();
+		for(auto& p:copy){
+			sum+=p.second;
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		long parallelSum=copy.parallel_reduce(0L,[](long s,const pair<const int,long>& p){return s+p.second;},[](long x,long y){return x+y;},threads);
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<endl;
+		if(sum!=parallelSum){
+			cout<<"Parallel reduction differs from the iteration."<<endl;
+		}
+	}
+	myfile.close();
+};
+
+template<class myOperation>
+double Timing_threads(int threads,int operations,myOperation operation){
+	vector<thread> workers;
+	atomic<long long> hits{0};
+	auto begin = chrono::high_resolution_clock::now();
+	for(int t=0;t<threads;++t){
+		workers.emplace_back([&operation,&hits,t,operations](){
+			unsigned seed=t*2654435761u+1;
+			long long found=0; // keeps the lookups from being optimized away
+			for(int i=0;i<operations;++i){
+				seed=seed*1103515245u+12345u; // rand() is not thread safe
+				found+=operation(seed>>1);
+			}
+			hits+=found;
+		});
+	}
+	for(auto& w:workers){
+		w.join();
+	}
+	auto end = chrono::high_resolution_clock::now();
+	return threads*double(operations)/chrono::duration_cast<chrono::microseconds>(end-begin).count();
+};
+
+void Benchmark_concurrent(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_concurrent.txt");
+	cout<<"Comparing concurrent lookup throughput."<<endl;
+	myfile<<"Reads%   threads   single mutex   sharded (operations per microsecond)"<<endl;
+	int n=1<<20, operations=200000, shards=64;
+	int maxThreads=max(2u,thread::hardware_concurrency());
+	vector<int> boundaries;
+	for(int i=1;i<shards;++i){
+		boundaries.push_back(int((long long)RAND_MAX*i/shards));
+	}
+	for(int reads:{100,90,50}){
+		for(int threads=1;threads<=maxThreads;threads*=2){
+			BinarySearchTree<int,int,less<int>,RedBlackBalancing> b;
+			mutex lock;
+			ConcurrentBinarySearchTree<int,int> c{boundaries};
+			for(int i=0;i<n;++i){
+				int x=rand();
+				b.insert(pair<int, int>{x,x});
+				c.insert(pair<int, int>{x,x});
+			}
+			double single=Timing_threads(threads,operations,[&](unsigned r){
+				int x=int(r%RAND_MAX);
+				lock_guard<mutex> guard{lock};
+				if(int(r%100)<reads){
+					return b.find(x)!=b.end();
+				}
+				return b.insert(pair<int, int>{x,x});
+			});
+			double sharded=Timing_threads(threads,operations,[&](unsigned r){
+				int x=int(r%RAND_MAX);
+				if(int(r%100)<reads){
+					return c.contains(x);
+				}
+				return c.insert(pair<int, int>{x,x});
+			});
+			myfile<<reads<<"        "<<threads<<"        "<<single<<"         "<<sharded<<endl;
+		}
+	}
+	myfile.close();
+};
+
+// Counting heap allocations and time per operation for hits on a tree with long string keys:
+// find with std::string, find with std::string_view through a transparent comparator,
+// operator[] and try_emplace. No allocation at all is expected.
+template<class myOperation>
+void Timing_string_hits(const string& name,const vector<string>& queries,myOperation operation,ofstream& myfile){
+	size_t initialAllocations=allocations;
+	auto begin = chrono::high_resolution_clock::now();
+	for(size_t i=0;i<queries.size();++i){
+		operation(queries[i]);
+	}
+	auto end = chrono::high_resolution_clock::now();
+	auto total=chrono::duration_cast<chrono::nanoseconds>(end-begin).count();
+	myfile<<name<<"        "<<(allocations-initialAllocations)/double(queries.size())<<"         "<<total/double(queries.size())<<endl;
+};
+
+void Benchmark_string_keys(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_string_keys.txt");
+	cout<<"Counting allocations with string keys."<<endl;
+	BinarySearchTree<string,int,less<>,RedBlackBalancing> b;
+	vector<string> queries;
+	for(int i=0;i<100000;++i){
+		string key="a_key_long_enough_to_be_allocated_"+to_string(rand());
+		b.insert(pair<string,int>{key,i});
+		queries.push_back(key);
+	}
+	long found=0;
+	myfile<<"operation   allocations per operation   time per operation"<<endl;
+	Timing_string_hits("find(string)",queries,[&](const string& key){ found+=(*b.find(key)).second; },myfile);
+	Timing_string_hits("find(string_view)",queries,[&](const string& key){ found+=(*b.find(string_view{key})).second; },myfile);
+	Timing_string_hits("operator[]",queries,[&](const string& key){ found+=b[key]; },myfile);
+	Timing_string_hits("try_emplace",queries,[&](const string& key){ found+=(*b.try_emplace(key,0).first).second; },myfile);
+	myfile.close();
+	if(found<0){
+		cout<<found<<endl;
+	}
+};
+
+void Benchmark_snapshot(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_snapshot.txt");
+	cout<<"Comparing ways of restoring a tree from disk."<<endl;
+	myfile<<"N   reinsertion   save   load   mmap_open (ms)   tree_find   mapped_find (ns per find)"<<endl;
+	using myTree=BinarySearchTree<int,int,less<int>,RedBlackBalancing>;
+	const char* path="test/benchmark_results/snapshot.bin";
+	for(int j=1<<16;j<=1<<22;j*=4){
+		myTree t;
+		vector<int> keys;
+		for(int i=0;i<j;++i){
+			int x=rand();
+			keys.push_back(x);
+			t.insert(pair<int, int>{x,x});
+		}
+		auto begin = chrono::high_resolution_clock::now();
+		myTree reinserted;
+		for(int x:keys){
+			reinserted.insert(pair<int, int>{x,x});
+		}
+		auto end = chrono::high_resolution_clock::now();
+		myfile<<j<<"        "<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		{
+			ofstream snapshot{path,ios::binary};
+			t.save(snapshot);
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		myTree loaded;
+		{
+			ifstream snapshot{path,ios::binary};
+			loaded.load(snapshot);
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		MappedBinarySearchTree<int,int> mapped{path};
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+		size_t hits=0;
+		begin = chrono::high_resolution_clock::now();
+		for(int x:keys){
+			hits+=t.find(x)!=t.cend();
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(j)<<"         ";
+		begin = chrono::high_resolution_clock::now();
+		for(int x:keys){
+			hits+=mapped.find(x)!=mapped.cend();
+		}
+		end = chrono::high_resolution_clock::now();
+		myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(j)<<endl;
+		found=found+hits;
+	}
+	remove(path);
+	myfile.close();
+};
+
+// Writes the ns per insert, per lookup and per scanned element of a container filled with random keys.
+template<class myType>
+void Timing_wide(const vector<int>& keys,const vector<int>& queries,ofstream& myfile){
+	myType b;
+	auto begin = chrono::high_resolution_clock::now();
+	for(int x:keys){
+		b.insert(pair<int, int>{x,x});
+	}
+	auto end = chrono::high_resolution_clock::now();
+	myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(keys.size())<<"         ";
+	myfile<<Timing_lookup(b,queries)<<"         ";
+	size_t sum=0, count=0;
+	begin = chrono::high_resolution_clock::now();
+	for(auto it=b.begin();it!=b.end();++it){
+		sum+=(*it).second;
+		++count;
+	}
+	end = chrono::high_resolution_clock::now();
+	found=found+sum;
+	myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(count)<<"         ";
+};
+void Benchmark_bplus_tree(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_bplus_tree.txt");
+	cout<<"Comparing B+ trees with binary trees."<<endl;
+	myfile<<"N   red-black tree: insert   find   scan   B+ tree: insert   find   scan   map: insert   find   scan (ns per operation)"<<endl;
+	for(int j=1<<16;j<=1<<22;j*=4){
+		vector<int> keys;
+		for(int i=0;i<j;++i){
+			keys.push_back(rand());
+		}
+		vector<int> queries;
+		for(int i=0;i<1000000;++i){
+			queries.push_back(keys[rand()%j]);
+		}
+		myfile<<j<<"        ";
+		Timing_wide<BinarySearchTree<int,int,less<int>,RedBlackBalancing>>(keys,queries,myfile);
+		Timing_wide<BPlusTree<int,int>>(keys,queries,myfile);
+		Timing_wide<map<int,int>>(keys,queries,myfile);
+		myfile<<endl;
+	}
+	myfile.close();
+};
+
+void Assign(BinarySearchTree<int,int,less<int>,RedBlackBalancing>& b,int key,int value){ (*b.try_emplace(key).first).second=value; };
+void Assign(PersistentBinarySearchTree<int,int>& b,int key,int value){ b.insert_or_assign(key,value); };
+
+// Writes the bytes per element of a tree, the ns to take a snapshot by copy, and the ms and the peak
+// of additional MB of a workload where each write is followed by 4 lookups on the oldest of the last
+// 4 snapshots, taken every 1000 writes, as if readers were still using them.
+template<class myTree>
+void Timing_versions(const vector<int>& keys,ofstream& myfile){
+	size_t before=allocatedBytes;
+	myTree b;
+	for(int x:keys){
+		b.insert(pair<int, int>{x,x});
+	}
+	size_t base=allocatedBytes;
+	myfile<<(base-before)/double(keys.size())<<"         ";
+	int copies=max<int>(1,(1<<20)/keys.size());
+	auto begin = chrono::high_resolution_clock::now();
+	for(int i=0;i<copies;++i){
+		myTree snapshot{b};
+		found=found+snapshot.size();
+	}
+	auto end = chrono::high_resolution_clock::now();
+	myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(copies)<<"         ";
+	peakAllocatedBytes.store(allocatedBytes.load());
+	size_t hits=0;
+	begin = chrono::high_resolution_clock::now();
+	{
+		deque<myTree> snapshots{b};
+		for(int i=0;i<20000;++i){
+			Assign(b,keys[rand()%keys.size()],i);
+			for(int j=0;j<4;++j){
+				hits+=snapshots.front().find(keys[rand()%keys.size()])!=snapshots.front().end();
+			}
+			if(i%1000==999){
+				snapshots.push_back(b);
+				if(snapshots.size()>4){
+					snapshots.pop_front();
+				}
+			}
+		}
+	}
+	end = chrono::high_resolution_clock::now();
+	found=found+hits;
+	myfile<<chrono::duration_cast<chrono::microseconds>(end-begin).count()/1000.<<"         ";
+	myfile<<(peakAllocatedBytes-base)/1048576.<<"         ";
+};
+void Benchmark_persistent(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_persistent.txt");
+	cout<<"Comparing snapshots by copy and by sharing nodes."<<endl;
+	myfile<<"N   red-black tree: bytes per element   snapshot (ns)   workload (ms)   peak additional memory (MB)   persistent tree: bytes per element   snapshot (ns)   workload (ms)   peak additional memory (MB)"<<endl;
+	for(int j=1<<16;j<=1<<20;j*=4){
+		vector<int> keys;
+		for(int i=0;i<j;++i){
+			keys.push_back(rand());
+		}
+		myfile<<j<<"        ";
+		Timing_versions<BinarySearchTree<int,int,less<int>,RedBlackBalancing>>(keys,myfile);
+		Timing_versions<PersistentBinarySearchTree<int,int>>(keys,myfile);
+		myfile<<endl;
+	}
+	myfile.close();
+};
+
+// Timing sorted insertions with the auto balance threshold on an unbalanced tree, which rebuilds
+// scapegoat subtrees, and on a red-black tree, which is balanced as a whole; the time per
+// insertion should stay O(log n). Lookups of all keys measure the resulting shapes.
+template<class myTree>
+void Timing_auto_balance(int n,ofstream& myfile){
+	myTree b;
+	b.auto_balance(2);
+	auto begin = chrono::high_resolution_clock::now();
+	for(int i=0;i<n;++i){
+		b.insert(pair<int, int>{i,i});
+	}
+	auto end = chrono::high_resolution_clock::now();
+	myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(n)<<"         ";
+	long long found=0;
+	begin = chrono::high_resolution_clock::now();
+	for(int i=0;i<n;++i){
+		found+=(*b.find(i)).second;
+	}
+	end = chrono::high_resolution_clock::now();
+	myfile<<chrono::duration_cast<chrono::nanoseconds>(end-begin).count()/double(n)<<"         "<<b.stats().height<<"         ";
+	if(found!=(long long)n*(n-1)/2){
+		cout<<"Automatically balanced tree lost elements."<<endl;
+	}
+};
+void Benchmark_auto_balance(){
+	ofstream myfile;
+	myfile.open ("test/benchmark_results/benchmark_auto_balance.txt");
+	cout<<"Timing sorted insertions with automatic balancing."<<endl;
+	myfile<<"N   unbalanced: insert   find (ns)   height   red-black: insert   find (ns)   height"<<endl;
+	for(int j=1<<14;j<=1<<20;j*=4){
+		myfile<<j<<"        ";
+		Timing_auto_balance<BinarySearchTree<int,int>>(j,myfile);
+		Timing_auto_balance<BinarySearchTree<int,int,less<int>,RedBlackBalancing>>(j,myfile);
+		myfile<<endl;
+	}
+	myfile.close();
+};
+
 int main(){
 	
 	Benchmark_different_type("int");
 	Benchmark_different_type("double");
 	Benchmark_Map();
+	Benchmark_allocation();
+	Benchmark_balance();
+	Benchmark_sorted_load();
+	Benchmark_frozen();
+	Benchmark_find_many();
+	Benchmark_string_keys();
+	Benchmark_order_statistics();
+	Benchmark_set_operations();
+	Benchmark_parallel();
+	Benchmark_concurrent();
+	Benchmark_snapshot();
+	Benchmark_bplus_tree();
+	Benchmark_persistent();
+	Benchmark_auto_balance();
 	return 0;
 };
@@ -0,0 +1,225 @@
+/**
+ * @file BinarySearchTreeSuite.cpp
+ * @author Giulia Franco
+ * @date 17 October 2026
+ * @brief Source file of the benchmark suite comparing the BinarySearchTree class with the standard containers.
+ *
+ * Every measure is run once as a warm-up and then repeated for a number of trials.
+ * The median, 99th percentile and minimum of the time per operation across trials
+ * are written to test/benchmark_results/suite.csv and suite.json, to be compared
+ * between versions. Usage: ./suite.o [trials] [log2 of the largest size]
+ */
+
+#include "BinarySearchTree.h"
+#include "BPlusTree.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Keeps the results of the measured operations alive, so that the compiler can't remove them.
+volatile size_t sink=0;
+
+struct Result{
+	string container;
+	string key;
+	string distribution;
+	string operation;
+	size_t n;
+	size_t trials;
+	double median;
+	double p99;
+	double min;
+};
+
+// Runs prepare() and then measure() once as a warm-up and then for every trial, only timing measure().
+// measure() returns the number of operations performed, the state built by prepare() is
+// destroyed after the timer is stopped. Returns the sorted nanoseconds per operation of every trial.
+template<class myPrepare,class myMeasure>
+vector<double> Trials(size_t trials,myPrepare prepare,myMeasure measure){
+	vector<double> samples;
+	for(size_t t=0;t<=trials;++t){
+		auto state=prepare();
+		auto begin=chrono::steady_clock::now();
+		size_t operations=measure(state);
+		auto end=chrono::steady_clock::now();
+		if(t){
+			samples.push_back(chrono::duration<double,nano>(end-begin).count()/max<size_t>(operations,1));
+		}
+	}
+	sort(samples.begin(),samples.end());
+	return samples;
+};
+
+// Nearest-rank percentile of sorted samples.
+double Percentile(const vector<double>& sorted,double p){
+	size_t rank=size_t(ceil(p*sorted.size()));
+	return sorted[rank?rank-1:0];
+};
+
+// Keys present in the containers have even ids, missing keys odd ids.
+template<class myKey> myKey MakeKey(uint64_t id);
+template<> int MakeKey<int>(uint64_t id){ return int(id); }
+template<> double MakeKey<double>(uint64_t id){ return id*0.5; }
+template<> string MakeKey<string>(uint64_t id){
+	char buffer[24];
+	snprintf(buffer,sizeof(buffer),"key%012llu",(unsigned long long)id);
+	return buffer;
+};
+
+// Ids of the n keys in the order of a workload: sequential, random permutation, or n Zipfian
+// draws (exponent 0.99) over the n keys, whose ranks are randomly permuted.
+vector<uint64_t> Workload(const string& distribution,size_t n,unsigned seed){
+	vector<uint64_t> ids(n);
+	iota(ids.begin(),ids.end(),0);
+	if(distribution=="sequential"){
+		return ids;
+	}
+	mt19937_64 generator{seed};
+	shuffle(ids.begin(),ids.end(),generator);
+	if(distribution=="random"){
+		return ids;
+	}
+	vector<double> cumulative(n);
+	double total=0;
+	for(size_t rank=0;rank<n;++rank){
+		total+=1/pow(rank+1.,0.99);
+		cumulative[rank]=total;
+	}
+	uniform_real_distribution<double> uniform{0,total};
+	vector<uint64_t> draws(n);
+	for(auto& draw:draws){
+		size_t rank=lower_bound(cumulative.begin(),cumulative.end(),uniform(generator))-cumulative.begin();
+		draw=ids[min(rank,n-1)];
+	}
+	return draws;
+};
+
+template<class myContainer>
+size_t Find(const myContainer& c,const vector<typename myContainer::key_type>& keys){
+	size_t hits=0;
+	for(const auto& key:keys){
+		hits+=c.find(key)!=c.end();
+	}
+	sink=sink+hits;
+	return keys.size();
+};
+
+template<class myContainer>
+size_t Iterate(const myContainer& c){
+	size_t sum=0, count=0;
+	for(const auto& pair:c){
+		sum+=pair.second;
+		++count;
+	}
+	sink=sink+sum;
+	return count;
+};
+
+template<class myContainer>
+void Balance(myContainer&){};
+
+template<class myKey,class myValue>
+void Balance(BinarySearchTree<myKey,myValue>& c){ c.balance(); };
+
+// Measures insert, find, find-miss, iterate and, for trees supporting it, balance on a container.
+template<class myContainer>
+void Benchmark_container(const string& name,const string& key,const string& distribution,size_t n,size_t trials,bool balance,vector<Result>& results){
+	using myKey=typename myContainer::key_type;
+	vector<uint64_t> order=Workload(distribution=="sequential"?"sequential":"random",n,1);
+	vector<uint64_t> queries=Workload(distribution,n,2);
+	vector<myKey> present, inserted, hits, misses;
+	for(auto id:order){
+		present.push_back(MakeKey<myKey>(2*id));
+	}
+	for(auto id:Workload(distribution,n,3)){
+		inserted.push_back(MakeKey<myKey>(2*id));
+	}
+	for(auto id:queries){
+		hits.push_back(MakeKey<myKey>(2*id));
+		misses.push_back(MakeKey<myKey>(2*id+1));
+	}
+	myContainer filled;
+	for(size_t i=0;i<n;++i){
+		filled.insert({present[i],i});
+	}
+	auto add=[&](const string& operation,const vector<double>& samples){
+		results.push_back(Result{name,key,distribution,operation,n,trials,Percentile(samples,0.5),Percentile(samples,0.99),samples.front()});
+		cout<<name<<" "<<key<<" "<<distribution<<" "<<operation<<" "<<n<<": "<<results.back().median<<" ns"<<endl;
+	};
+	add("insert",Trials(trials,[](){ return myContainer{}; },[&](myContainer& c){
+		for(size_t i=0;i<n;++i){
+			c.insert({inserted[i],i});
+		}
+		return n;
+	}));
+	add("find",Trials(trials,[](){ return 0; },[&](int){ return Find(filled,hits); }));
+	add("find-miss",Trials(trials,[](){ return 0; },[&](int){ return Find(filled,misses); }));
+	add("iterate",Trials(trials,[](){ return 0; },[&](int){ return Iterate(filled); }));
+	if(balance){
+		add("balance",Trials(trials,[&](){ return myContainer{filled}; },[&](myContainer& c){
+			Balance(c);
+			return n;
+		}));
+	}
+};
+
+template<class myKey>
+void Benchmark_key(const string& key,size_t maxExponent,size_t trials,vector<Result>& results){
+	for(string distribution:{"random","sequential","zipfian"}){
+		for(size_t exponent=10;exponent<=maxExponent;exponent+=4){
+			size_t n=size_t(1)<<exponent;
+			if(distribution!="sequential"||exponent<=14){ // Sequential keys degenerate the unbalanced tree into a list
+				Benchmark_container<BinarySearchTree<myKey,size_t>>("bst",key,distribution,n,trials,true,results);
+			}
+			Benchmark_container<BinarySearchTree<myKey,size_t,less<myKey>,RedBlackBalancing,PoolAllocation<>>>("bst_red_black_pool",key,distribution,n,trials,false,results);
+			Benchmark_container<BPlusTree<myKey,size_t>>("bplus_tree",key,distribution,n,trials,false,results);
+			Benchmark_container<map<myKey,size_t>>("map",key,distribution,n,trials,false,results);
+			Benchmark_container<unordered_map<myKey,size_t>>("unordered_map",key,distribution,n,trials,false,results);
+		}
+	}
+};
+
+void Write_results(const vector<Result>& results){
+	ofstream csv;
+	csv.open("test/benchmark_results/suite.csv");
+	csv<<"container,key,distribution,operation,n,trials,median_ns,p99_ns,min_ns"<<endl;
+	for(auto& r:results){
+		csv<<r.container<<","<<r.key<<","<<r.distribution<<","<<r.operation<<","<<r.n<<","<<r.trials<<","<<r.median<<","<<r.p99<<","<<r.min<<endl;
+	}
+	csv.close();
+	ofstream json;
+	json.open("test/benchmark_results/suite.json");
+	json<<"["<<endl;
+	for(size_t i=0;i<results.size();++i){
+		auto& r=results[i];
+		json<<"  {\"container\": \""<<r.container<<"\", \"key\": \""<<r.key<<"\", \"distribution\": \""<<r.distribution
+			<<"\", \"operation\": \""<<r.operation<<"\", \"n\": "<<r.n<<", \"trials\": "<<r.trials
+			<<", \"median_ns\": "<<r.median<<", \"p99_ns\": "<<r.p99<<", \"min_ns\": "<<r.min<<"}"<<(i+1<results.size()?",":"")<<endl;
+	}
+	json<<"]"<<endl;
+	json.close();
+};
+
+int main(int argc,char** argv){
+	size_t trials=argc>1?strtoul(argv[1],nullptr,10):10;
+	size_t maxExponent=argc>2?strtoul(argv[2],nullptr,10):18;
+	vector<Result> results;
+	Benchmark_key<int>("int",maxExponent,max<size_t>(trials,1),results);
+	Benchmark_key<double>("double",maxExponent,max<size_t>(trials,1),results);
+	Benchmark_key<string>("string",maxExponent,max<size_t>(trials,1),results);
+	Write_results(results);
+	return 0;
+};
@@ -5,6 +5,19 @@
  * @brief Source file to perform various tests on the BinarySearchTree class.
  */
 #include "BinarySearchTree.h"
+#include "BPlusTree.h"
+#include "ConcurrentBinarySearchTree.h"
+#include "MappedBinarySearchTree.h"
+#include "PersistentBinarySearchTree.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string_view>
+#include <thread>
 
 void test_template_comparison()
 {
@@ -20,6 +33,753 @@ void test_template_comparison()
     std::cout << t1 << std::endl;
 };
 
+template <class TBalance>
+void test_balancing_policy(const std::string& name)
+{
+    BinarySearchTree<int,int,std::less<int>,TBalance> t;
+    for(int i=1; i<=7; i++)
+    {
+        t.insert({i, i});
+    }
+    std::cout << "\ninserted 1..7 in ascending order with " << name << " balancing" << std::endl;
+    t.printTree(std::cout); // should be rooted in 4 (AVL) or 2 (red-black) instead of being a list
+    for(int i=8; i<=10000; i++)
+    {
+        t.insert({i, i});
+    }
+    int expected = 1;
+    for(auto it = t.begin(); it != t.end(); ++it, ++expected)
+    {
+        if((*it).first != expected || t.find(expected) == t.end())
+        {
+            throw std::runtime_error(name + " balancing broke the tree order");
+        }
+    }
+    if(!t.verify())
+    {
+        throw std::runtime_error(name + " balancing broke its invariants on ascending keys");
+    }
+    for(unsigned int seed=1; seed<=2000; seed++) // random orders exercise every rotation case
+    {
+        BinarySearchTree<int,int,std::less<int>,TBalance> r;
+        unsigned int state = seed;
+        for(int i=0; i<200; i++)
+        {
+            state = state * 1103515245u + 12345u;
+            r.insert({int(state >> 16), i});
+        }
+        if(!r.verify())
+        {
+            throw std::runtime_error(name + " balancing broke its invariants with seed " + std::to_string(seed));
+        }
+    }
+};
+
+template <class TKey>
+void test_pool_allocation(TKey (*makeKey)(int))
+{
+    BinarySearchTree<TKey,int,std::less<TKey>,RedBlackBalancing,PoolAllocation<16>> t;
+    for(int i=0; i<1000; i++)
+    {
+        t.insert({makeKey(i), i});
+    }
+    BinarySearchTree<TKey,int,std::less<TKey>,RedBlackBalancing,PoolAllocation<16>> copied{t};
+    t.clear(); // releases the whole arena
+    if(t.begin() != t.end() || copied.find(makeKey(999)) == copied.end())
+    {
+        throw std::runtime_error("pool allocated tree was not cleared correctly");
+    }
+    t = std::move(copied);
+    t.insert({makeKey(1000), 1000});
+    if((*t.find(makeKey(500))).second != 500 || (*t.find(makeKey(1000))).second != 1000)
+    {
+        throw std::runtime_error("pool allocated tree lost its elements");
+    }
+};
+
+void test_copy_and_teardown()
+{
+    BinarySearchTree<int,int> t;
+    std::vector<int> v{4,2,6,1,3,5,7,8};
+    for(int key : v)
+    {
+        t.insert({key, key});
+    }
+    BinarySearchTree<int,int> copied{t};
+    std::ostringstream original, copy;
+    t.printTree(original);
+    copied.printTree(copy);
+    if(original.str() != copy.str())
+    {
+        throw std::runtime_error("copy did not preserve the tree structure");
+    }
+    copied = copied; // self assignment should be a no-op
+    BinarySearchTree<int,int> degenerate;
+    for(int i=0; i<5000; i++)
+    {
+        degenerate.insert({i, i});
+    }
+    BinarySearchTree<int,int> degenerateCopy{degenerate};
+    degenerate.clear(); // no recursion, even on a 5000 levels tree
+    if((*degenerateCopy.find(4999)).second != 4999 || copied.find(8) == copied.end())
+    {
+        throw std::runtime_error("copied tree lost its elements");
+    }
+};
+
+template <class TBalance>
+void test_in_place_balance()
+{
+    BinarySearchTree<int,std::string,std::less<int>,TBalance> t;
+    for(int i=1; i<=12; i++)
+    {
+        t.insert({(i * 5) % 13, std::to_string(i)}); // inserts 5,10,2,7,12,4,9,1,6,11,3,8
+    }
+    t.balance();
+    std::cout << "\nbalanced in place a tree with keys 1..12" << std::endl;
+    t.printTree(std::cout);
+    for(int i=13; i<=100; i++) // the balancing data must still be valid after balance()
+    {
+        t.insert({i, std::to_string(i)});
+    }
+    int expected = 1;
+    for(auto it = t.begin(); it != t.end(); ++it, ++expected)
+    {
+        if((*it).first != expected || t.find(expected) == t.end())
+        {
+            throw std::runtime_error("in place balance broke the tree order");
+        }
+    }
+};
+
+void test_bulk_load_and_hint()
+{
+    std::vector<std::pair<int,int>> sorted{{1,1},{2,2},{3,3},{3,30},{4,4},{5,5},{6,6},{7,7}};
+    BinarySearchTree<int,int> t{sorted.begin(), sorted.end()}; // the duplicated key 3 is skipped
+    std::cout << "\nbuilt from the sorted range 1..7" << std::endl;
+    t.printTree(std::cout);
+    BinarySearchTree<int,int> appended;
+    auto hint = appended.end();
+    for(int i=0; i<10000; i++) // each insertion appends past the maximum in O(1)
+    {
+        hint = i % 2 ? appended.insert(hint, {i, i}) : appended.insert(appended.end(), {i, i});
+    }
+    appended.insert(appended.begin(), {-1, -1}); // hinted insertion before the minimum
+    if((*appended.insert(appended.end(), {500, 0})).second != 500) // the hint is ignored
+    {
+        throw std::runtime_error("hinted insertion overwrote an existing element");
+    }
+    int expected = -1;
+    for(auto it = appended.begin(); it != appended.end(); ++it, ++expected)
+    {
+        if((*it).first != expected)
+        {
+            throw std::runtime_error("hinted insertion broke the tree order");
+        }
+    }
+    t.assign(appended.begin(), appended.end());
+    if(t.find(9999) == t.end() || t.find(-1) == t.end())
+    {
+        throw std::runtime_error("assign lost some elements");
+    }
+};
+
+void test_freeze()
+{
+    BinarySearchTree<int,int,std::less<int>,RedBlackBalancing> t;
+    for(int i=0; i<1000; i++)
+    {
+        t.insert({(i * 7) % 1000, i});
+    }
+    FrozenBinarySearchTree<int,int> frozen{t.freeze()};
+    auto it = t.cbegin();
+    for(auto frozenIt = frozen.cbegin(); frozenIt != frozen.cend(); ++frozenIt, ++it)
+    {
+        if((*frozenIt).first != (*it).first || (*frozenIt).second != (*it).second)
+        {
+            throw std::runtime_error("frozen tree iteration differs from the tree one");
+        }
+    }
+    if(it != t.cend() || frozen.size() != 1000 || frozen.find(-1) != frozen.end() || frozen.find(1000) != frozen.end())
+    {
+        throw std::runtime_error("frozen tree has a wrong number of elements");
+    }
+    for(int i=0; i<1000; i++)
+    {
+        if(frozen[(i * 7) % 1000] != i)
+        {
+            throw std::runtime_error("frozen tree lookup returned a wrong value");
+        }
+    }
+    try
+    {
+        frozen[1000];
+        throw std::runtime_error("frozen tree lookup of a missing key did not throw");
+    }
+    catch(std::out_of_range&) {}
+    FrozenBinarySearchTree<int,int> moved{std::move(frozen)};
+    if(frozen.size() != 0 || frozen.find(3) != frozen.end() || frozen.begin() != frozen.end() || moved.size() != 1000 || moved[7] != 1)
+    {
+        throw std::runtime_error("moved frozen tree is not empty");
+    }
+    frozen = std::move(moved);
+    if(moved.size() != 0 || moved.find(3) != moved.end() || frozen.size() != 1000 || frozen[7] != 1)
+    {
+        throw std::runtime_error("moved assigned frozen tree is not empty");
+    }
+    std::cout << "\nfrozen tree of keys 1..3" << std::endl;
+    std::vector<std::pair<int,int>> small{{1,1},{2,2},{3,3}};
+    std::cout << FrozenBinarySearchTree<int,int>{small.begin(), small.end()} << FrozenBinarySearchTree<int,int>{} << std::endl;
+};
+
+void test_find_many()
+{
+    BinarySearchTree<int,int> t;
+    for(int i=0; i<1000; i++)
+    {
+        t.insert({(i * 7) % 1000 * 2, i}); // even keys only
+    }
+    std::vector<int> keys;
+    for(int i=0; i<100; i++)
+    {
+        keys.push_back((i * 13) % 2001); // both present and missing keys
+    }
+    std::vector<BinarySearchTree<int,int>::Iterator> results;
+    t.find_many(keys.begin(), keys.end(), std::back_inserter(results));
+    if(results.size() != keys.size())
+    {
+        throw std::runtime_error("find_many returned a wrong number of results");
+    }
+    for(std::size_t i=0; i<keys.size(); i++)
+    {
+        if(results[i] != t.find(keys[i]))
+        {
+            throw std::runtime_error("find_many result differs from the find one");
+        }
+    }
+};
+
+struct CaseInsensitiveLess
+{
+    bool operator()(const std::string& a, const std::string& b) const
+    {
+        return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+            [](char x, char y) { return std::tolower(x) < std::tolower(y); });
+    }
+};
+
+void test_emplace_and_heterogeneous_lookup()
+{
+    BinarySearchTree<std::string,std::string,std::less<>> t;
+    std::string longKey(40, 'k');
+    std::string longValue(40, 'v');
+    t.insert({longKey, longValue});
+    std::pair<std::string,std::string> duplicate{longKey, longValue};
+    if(t.insert(std::move(duplicate)) || duplicate.second != longValue) // nothing moved if present
+    {
+        throw std::runtime_error("insert moved a pair whose key was already present");
+    }
+    if(t.try_emplace(longKey, "other").second || (*t.find(longKey)).second != longValue)
+    {
+        throw std::runtime_error("try_emplace replaced an existing value");
+    }
+    auto emplaced = t.emplace(std::piecewise_construct, std::forward_as_tuple("abc"), std::forward_as_tuple(3, 'x'));
+    if(!emplaced.second || (*emplaced.first).second != "xxx")
+    {
+        throw std::runtime_error("emplace did not build the pair in place");
+    }
+    t["def"] += "appended"; // inserts a default value with a single traversal
+    if(t.find(std::string_view{"def"}) == t.end() || (*t.find("def")).second != "appended")
+    {
+        throw std::runtime_error("operator[] or heterogeneous find failed");
+    }
+    const auto& constTree = t;
+    try
+    {
+        constTree["missing"];
+        throw std::runtime_error("const operator[] on a missing key did not throw");
+    }
+    catch(std::out_of_range&) {}
+    BinarySearchTree<std::string,int,CaseInsensitiveLess> caseInsensitive;
+    caseInsensitive.insert({"Key", 1});
+    if(caseInsensitive.find("KEY") == caseInsensitive.end() || caseInsensitive["kEy"] != 1)
+    {
+        throw std::runtime_error("find did not use the comparator equivalence");
+    }
+};
+
+template <class TBalance>
+void test_order_statistics()
+{
+    BinarySearchTree<int,int,std::less<int>,TBalance,HeapAllocation,OrderStatistics> t;
+    std::vector<int> keys;
+    for(int i=0; i<500; i++)
+    {
+        keys.push_back((i * 37) % 500 * 3); // multiples of 3 in scrambled order
+        t.insert({keys.back(), i});
+    }
+    std::sort(keys.begin(), keys.end());
+    for(int round=0; round<2; round++)
+    {
+        for(std::size_t k=0; k<keys.size(); k++)
+        {
+            if((*t.select(k)).first != keys[k] || t.rank(keys[k]) != k || t.rank(keys[k] + 1) != k + 1)
+            {
+                throw std::runtime_error("rank or select differ from the sorted keys");
+            }
+        }
+        if(t.select(keys.size()) != t.end() || t.count_range(10, 100) != 30 || t.count_range(100, 10) != 0)
+        {
+            throw std::runtime_error("select or count_range out of the tree range");
+        }
+        t.balance(); // sizes have to be recomputed
+    }
+};
+
+void test_bounds()
+{
+    BinarySearchTree<int,int> t;
+    for(int i=0; i<100; i++)
+    {
+        t.insert({(i * 7) % 100 * 2, i}); // even keys only
+    }
+    if((*t.lower_bound(10)).first != 10 || (*t.lower_bound(11)).first != 12 || (*t.upper_bound(10)).first != 12)
+    {
+        throw std::runtime_error("wrong lower or upper bound");
+    }
+    if(t.lower_bound(199) != t.end() || t.upper_bound(198) != t.end() || t.lower_bound(-5) != t.begin())
+    {
+        throw std::runtime_error("wrong bound out of the tree range");
+    }
+    auto range = t.equal_range(20);
+    if(range.first == range.second || ++range.first != range.second || (*t.equal_range(20).first).first != 20)
+    {
+        throw std::runtime_error("wrong equal range");
+    }
+};
+
+template <class TAllocator>
+void test_set_operations()
+{
+    using Tree = BinarySearchTree<int,int,std::less<int>,RedBlackBalancing,TAllocator,OrderStatistics>;
+    Tree evens, thirds;
+    for(int i=0; i<300; i++)
+    {
+        evens.insert({i * 2, 1});
+        thirds.insert({i * 3, 2});
+    }
+    auto keys = [](const Tree& t)
+    {
+        std::vector<int> result;
+        for(const auto& pair : t)
+        {
+            result.push_back(pair.first);
+        }
+        return result;
+    };
+    std::vector<int> a{keys(evens)}, b{keys(thirds)}, expected;
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    if(keys(evens.set_union(thirds)) != expected || evens.set_union(thirds)[6] != 1)
+    {
+        throw std::runtime_error("wrong set union");
+    }
+    expected.clear();
+    std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    if(keys(evens.set_intersection(thirds)) != expected)
+    {
+        throw std::runtime_error("wrong set intersection");
+    }
+    expected.clear();
+    std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+    if(keys(evens.set_difference(thirds)) != expected)
+    {
+        throw std::runtime_error("wrong set difference");
+    }
+    Tree merged{evens};
+    merged.merge(Tree{thirds});
+    Tree greater{merged.split(400)};
+    std::size_t lessSize = merged.rank(400), greaterSize = greater.rank(1000);
+    if((*merged.select(lessSize - 1)).first >= 400 || (*greater.begin()).first != 400 || greater.rank(400) != 0)
+    {
+        throw std::runtime_error("wrong split");
+    }
+    merged.join(std::move(greater));
+    if(keys(merged) != keys(evens.set_union(thirds)) || merged.rank(1000) != lessSize + greaterSize || greater.begin() != greater.end())
+    {
+        throw std::runtime_error("wrong merge or join");
+    }
+    try
+    {
+        merged.join(Tree{thirds});
+        throw std::runtime_error("join accepted overlapping keys");
+    }
+    catch(std::invalid_argument&) {}
+};
+
+void test_parallel_operations()
+{
+    BinarySearchTree<int,long,std::less<int>,AVLBalancing,HeapAllocation,OrderStatistics> t;
+    long expected = 0;
+    for(int i=0; i<3000; i++)
+    {
+        t.insert({i, i}); // sorted keys, the AVL tree is not perfectly balanced
+        expected += 2 * i;
+    }
+    t.parallel_for_each([](std::pair<const int, long>& pair){ pair.second *= 2; }, 4);
+    t.parallel_balance(4);
+    long sum = t.parallel_reduce(0L, [](long s, const std::pair<const int, long>& pair){ return s + pair.second; }, [](long a, long b){ return a + b; }, 4);
+    std::string keys = t.parallel_reduce(std::string{}, [](std::string s, const std::pair<const int, long>& pair){ return s + char('a' + pair.first % 26); }, [](std::string a, std::string b){ return a + b; }, 3);
+    if(sum != expected || keys.size() != 3000 || keys.substr(0, 28) != "abcdefghijklmnopqrstuvwxyzab")
+    {
+        throw std::runtime_error("wrong parallel reduction");
+    }
+    for(int i=0; i<3000; i+=7)
+    {
+        if((*t.select(i)).first != i || t[i] != 2 * i)
+        {
+            throw std::runtime_error("wrong tree after parallel balance");
+        }
+    }
+};
+
+void test_statistics()
+{
+    BinarySearchTree<int,int> t;
+    for(int i=0; i<100; i++)
+    {
+        t.insert({i, i}); // degenerate tree
+    }
+    auto stats = t.stats();
+    if(stats.size != 100 || t.size() != 100 || stats.height != 100 || stats.maxDepth != 99 || stats.averageDepth != 49.5 || stats.depthHistogram != std::vector<std::size_t>(100, 1))
+    {
+        throw std::runtime_error("wrong statistics of a degenerate tree");
+    }
+    t.balance();
+    stats = t.stats();
+    if(stats.height != 7 || stats.depthHistogram.front() != 1 || stats.depthHistogram.back() != 100 - 63)
+    {
+        throw std::runtime_error("wrong statistics of a balanced tree");
+    }
+    BinarySearchTree<int,int> automatic;
+    automatic.auto_balance(2);
+    for(int i=0; i<1000; i++)
+    {
+        automatic.insert({i, i});
+    }
+    if(automatic.stats().height > 2 * 10 || automatic.size() != 1000)
+    {
+        throw std::runtime_error("tree not balanced automatically");
+    }
+    BinarySearchTree<int,int,std::less<int>,NoBalancing,HeapAllocation,OrderStatistics> sorted;
+    sorted.auto_balance(2);
+    for(int i=0; i<200000; i++) // sorted insertions only rebuild small subtrees near the rightmost node
+    {
+        sorted.insert({i, i});
+    }
+    if(sorted.stats().height > 2 * 18 + 1 || sorted.rank(150000) != 150000 || (*sorted.select(123456)).first != 123456)
+    {
+        throw std::runtime_error("sorted tree not balanced automatically");
+    }
+    BinarySearchTree<int,int,std::less<int>,RedBlackBalancing> redBlack;
+    redBlack.auto_balance(1.1); // rebuilt as a whole, at most once every n/2 insertions
+    for(int i=0; i<100000; i++)
+    {
+        redBlack.insert({i, i});
+    }
+    if(!redBlack.verify() || redBlack.size() != 100000)
+    {
+        throw std::runtime_error("red-black tree broken by automatic balances");
+    }
+    automatic.reset_counters();
+    automatic.find(10);
+    auto counters = automatic.counters();
+    #ifdef BSTCOUNTERS
+    if(counters.finds != 1 || counters.visitedNodes == 0 || counters.comparisons < counters.visitedNodes)
+    #else
+    if(counters.finds != 0 || counters.visitedNodes != 0 || counters.comparisons != 0)
+    #endif
+    {
+        throw std::runtime_error("wrong operation counters");
+    }
+    automatic.reset_counters();
+    automatic.insert(automatic.end(), {1000, 1000}); // a single comparison with the rightmost node
+    counters = automatic.counters();
+    #ifdef BSTCOUNTERS
+    if(counters.inserts != 1 || counters.comparisons != 1)
+    #else
+    if(counters.inserts != 0 || counters.comparisons != 0)
+    #endif
+    {
+        throw std::runtime_error("wrong operation counters of a hinted insertion");
+    }
+    automatic.reset_counters();
+    automatic.insert(automatic.begin(), {2000, 2000}); // wrong hint, the insertion falls back to a search
+    counters = automatic.counters();
+    #ifdef BSTCOUNTERS
+    if(counters.inserts != 1 || counters.comparisons < counters.visitedNodes + 2)
+    #else
+    if(counters.inserts != 0 || counters.comparisons != 0)
+    #endif
+    {
+        throw std::runtime_error("wrong operation counters of a hinted insertion with a wrong hint");
+    }
+};
+
+void test_concurrent()
+{
+    ConcurrentBinarySearchTree<int,int> t{{250, 500, 750}};
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> threads;
+    for(int w=0; w<4; w++)
+    {
+        threads.emplace_back([&t, w]()
+        {
+            for(int i=w; i<1000; i+=4)
+            {
+                t.insert({i, i});
+                t.update(i, [](int& value){ value *= 2; });
+            }
+        });
+        threads.emplace_back([&t, &torn]()
+        {
+            for(int i=0; i<1000; i++)
+            {
+                std::optional<int> value{t.find(i)};
+                if(value && *value != i && *value != 2 * i)
+                {
+                    torn = true;
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    if(torn)
+    {
+        throw std::runtime_error("concurrent find returned a torn value");
+    }
+    int expected = 0;
+    t.for_each([&expected](const std::pair<const int, int>& pair)
+    {
+        if(pair.first != expected || pair.second != 2 * expected)
+        {
+            throw std::runtime_error("concurrent inserts lost or misplaced an element");
+        }
+        ++expected;
+    });
+    if(expected != 1000 || t.insert({3, 3}) || !t.contains(999) || t.contains(1000))
+    {
+        throw std::runtime_error("wrong concurrent tree content");
+    }
+};
+
+template <class TTree>
+bool sameElements(const TTree& a, const TTree& b)
+{
+    typename TTree::ConstIterator it{b.cbegin()};
+    for(typename TTree::ConstIterator jt{a.cbegin()}; jt != a.cend(); ++jt, ++it)
+    {
+        if(it == b.cend() || *it != *jt)
+        {
+            return false;
+        }
+    }
+    return it == b.cend();
+};
+
+template <class TTree>
+bool loadFails(TTree& t, const std::string& snapshot)
+{
+    std::istringstream is{snapshot};
+    try
+    {
+        t.load(is);
+    }
+    catch(std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+};
+
+void test_snapshots()
+{
+    BinarySearchTree<int,double,std::less<int>,RedBlackBalancing> t;
+    for(int i=0; i<1000; i++)
+    {
+        t.insert({(i * 7919) % 1000, i * 0.5});
+    }
+    std::ostringstream os;
+    t.save(os);
+    BinarySearchTree<int,double,std::less<int>,RedBlackBalancing> loaded;
+    std::istringstream is{os.str()};
+    loaded.load(is);
+    if(loaded.size() != 1000 || loaded.stats().height != 10 || !sameElements(t, loaded))
+    {
+        throw std::runtime_error("wrong tree loaded from a snapshot");
+    }
+    std::string corrupted{os.str()};
+    corrupted[100] ^= 1;
+    BinarySearchTree<int,float> otherTypes;
+    if(!loadFails(loaded, corrupted) || !loadFails(loaded, os.str().substr(0, 500)) || !loadFails(otherTypes, os.str()) || loaded.size() != 1000)
+    {
+        throw std::runtime_error("corrupted, truncated or mismatched snapshot loaded");
+    }
+    std::ostringstream sameSize;
+    otherTypes.insert({1, 1.5f});
+    otherTypes.save(sameSize);
+    BinarySearchTree<float,int> swappedTypes;
+    BinarySearchTree<int,int> integerTypes;
+    BinarySearchTree<int,unsigned int> unsignedTypes;
+    if(!loadFails(swappedTypes, sameSize.str()) || !loadFails(integerTypes, sameSize.str()) || !loadFails(unsignedTypes, sameSize.str()))
+    {
+        throw std::runtime_error("snapshot loaded into types of the same size");
+    }
+    BinarySearchTree<std::string,std::string> strings;
+    for(int i=0; i<100; i++)
+    {
+        strings.insert({"key" + std::to_string(i), std::string(i, 'x')});
+    }
+    std::stringstream ss;
+    strings.save(ss);
+    BinarySearchTree<std::string,std::string> loadedStrings;
+    loadedStrings.load(ss);
+    if(loadedStrings.size() != 100 || !sameElements(strings, loadedStrings))
+    {
+        throw std::runtime_error("wrong string tree loaded from a snapshot");
+    }
+    const char * path = "test_snapshot.bin";
+    {
+        std::ofstream file{path, std::ios::binary};
+        t.save(file);
+    }
+    try
+    {
+        MappedBinarySearchTree<float,double> otherMapped{path};
+        throw std::logic_error("snapshot mapped with a key type of the same size");
+    }
+    catch(std::runtime_error&)
+    {
+    }
+    MappedBinarySearchTree<int,double> mapped{path};
+    std::remove(path); // The mapping stays valid after the file is unlinked
+    if(mapped.size() != 1000 || !mapped.verify() || mapped[999] != t[999] || mapped.find(1000) != mapped.cend() || mapped.find(-1) != mapped.cend())
+    {
+        throw std::runtime_error("wrong mapped snapshot");
+    }
+    BinarySearchTree<int,double,std::less<int>,RedBlackBalancing>::ConstIterator it{t.cbegin()};
+    for(auto pair : mapped)
+    {
+        if(pair.first != (*it).first || pair.second != (*it).second || mapped.find(pair.first) == mapped.cend())
+        {
+            throw std::runtime_error("wrong mapped snapshot iteration or lookup");
+        }
+        ++it;
+    }
+};
+
+template <class TKey>
+void test_bplus_tree(TKey (*makeKey)(int))
+{
+    using SmallTree = BPlusTree<TKey,int,std::less<TKey>,std::is_arithmetic<TKey>::value ? 64 : 192>; // Small nodes, to test splits on many levels
+    SmallTree t;
+    BinarySearchTree<TKey,int> reference;
+    for(int i=0; i<5000; i++)
+    {
+        int x = (i * 7919) % 5003;
+        if(t.insert({makeKey(x), x}) != reference.insert({makeKey(x), x}))
+        {
+            throw std::runtime_error("wrong B+ tree insertion result");
+        }
+    }
+    typename BinarySearchTree<TKey,int>::ConstIterator it{reference.cbegin()};
+    for(auto pair : t)
+    {
+        if(it == reference.cend() || pair.first != (*it).first || pair.second != (*it).second)
+        {
+            throw std::runtime_error("wrong B+ tree iteration");
+        }
+        ++it;
+    }
+    for(int x=-1; x<5010; x++)
+    {
+        bool present = reference.find(makeKey(x)) != reference.end();
+        typename SmallTree::Iterator bound{t.lower_bound(makeKey(x))};
+        if(t.size() != reference.size() || (t.find(makeKey(x)) != t.end()) != present || (present && (*bound).first != makeKey(x)))
+        {
+            throw std::runtime_error("wrong B+ tree lookup");
+        }
+    }
+    SmallTree loaded{reference.cbegin(), reference.cend()};
+    loaded[makeKey(6000)] = 7;
+    const SmallTree copy{loaded};
+    auto range = copy.equal_range(makeKey(42));
+    if(copy.size() != t.size() + 1 || copy[makeKey(6000)] != 7 || copy[makeKey(42)] != 42 || range.first != copy.find(makeKey(42)) || ++range.first != range.second)
+    {
+        throw std::runtime_error("wrong B+ tree bulk load or copy");
+    }
+};
+
+// Value counting its live instances, to check that shared nodes are released.
+struct CountedValue
+{
+    static int live;
+    int value;
+    CountedValue(int v = 0) : value{v} { ++live; }
+    CountedValue(const CountedValue& other) : value{other.value} { ++live; }
+    CountedValue& operator=(const CountedValue&) = default;
+    ~CountedValue() { --live; }
+};
+int CountedValue::live = 0;
+
+void test_persistent()
+{
+    {
+        PersistentBinarySearchTree<int,CountedValue> t;
+        for(int i=0; i<1000; i++)
+        {
+            t.insert({(i * 7919) % 1000, CountedValue{i}});
+        }
+        PersistentBinarySearchTree<int,CountedValue> snapshot{t.snapshot()};
+        if(CountedValue::live != 1000)
+        {
+            throw std::runtime_error("snapshot copied the nodes");
+        }
+        t.insert_or_assign(500, CountedValue{-1});
+        t.insert({1000, CountedValue{1000}});
+        if(t.size() != 1001 || snapshot.size() != 1000 || t[500].value != -1 || snapshot[500].value == -1 || snapshot.find(1000) != snapshot.cend())
+        {
+            throw std::runtime_error("snapshot changed by a later modification");
+        }
+        if(CountedValue::live > 1001 + 2 * 2 * 10) // Two paths of at most 2 log2(n) nodes were copied
+        {
+            throw std::runtime_error("modification copied more than a path");
+        }
+        int expected = 0;
+        for(const auto& pair : snapshot)
+        {
+            if(pair.first != expected++)
+            {
+                throw std::runtime_error("wrong snapshot iteration");
+            }
+        }
+        snapshot.clear();
+        if(CountedValue::live != 1001 || expected != 1000)
+        {
+            throw std::runtime_error("nodes of a dropped snapshot not released");
+        }
+    }
+    if(CountedValue::live != 0)
+    {
+        throw std::runtime_error("persistent tree nodes leaked");
+    }
+};
+
+int intKey(int i) { return i; }
+std::string stringKey(int i) { return "key" + std::to_string(i); }
+
 //	Initial consideration: 'BinarySearchTree.h' methods call 
 //  the functions defined in 'BinarySearchTreeSubclasses.hxx', 
 //  also tested by calling the formal ones.
@@ -86,6 +846,63 @@ int main()
             std::cout << bst[Key] << std::endl;
             test_template_comparison();	
 
+        //  Testing balancing policies
+            test_balancing_policy<AVLBalancing>("AVL");
+            test_balancing_policy<RedBlackBalancing>("red-black");
+
+        //  Testing pool allocation with trivially and non trivially destructible keys
+            test_pool_allocation<int>(intKey);
+            test_pool_allocation<std::string>(stringKey);
+
+        //  Testing structure preserving copy and iterative destruction
+            test_copy_and_teardown();
+
+        //  Testing in place balance with every balancing policy
+            test_in_place_balance<NoBalancing>();
+            test_in_place_balance<AVLBalancing>();
+            test_in_place_balance<RedBlackBalancing>();
+
+        //  Testing bulk load from sorted ranges and hinted insertion
+            test_bulk_load_and_hint();
+
+        //  Testing read-optimized frozen snapshots
+            test_freeze();
+
+        //  Testing batched lookups
+            test_find_many();
+
+        //  Testing emplacement and heterogeneous lookup
+            test_emplace_and_heterogeneous_lookup();
+
+        //  Testing bounds and order statistics
+            test_bounds();
+            test_order_statistics<NoBalancing>();
+            test_order_statistics<AVLBalancing>();
+            test_order_statistics<RedBlackBalancing>();
+
+        //  Testing merge, split, join and set operations
+            test_set_operations<HeapAllocation>();
+            test_set_operations<PoolAllocation<64>>();
+
+        //  Testing multithreaded balance and traversals
+            test_parallel_operations();
+
+        //  Testing shape statistics, operation counters and automatic balance
+            test_statistics();
+
+        //  Testing concurrent writers and readers on a sharded tree
+            test_concurrent();
+
+        //  Testing binary snapshots and memory-mapped views
+            test_snapshots();
+
+        //  Testing the B+ tree with arithmetic and string keys
+            test_bplus_tree<int>(intKey);
+            test_bplus_tree<std::string>(stringKey);
+
+        //  Testing persistent trees with shared nodes and O(1) snapshots
+            test_persistent();
+
     }
     catch (std::runtime_error& e) 
     {